@@ -0,0 +1,77 @@
+#include "lexer.h"
+#include "dfa_lexer.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+std::string readFile(const std::filesystem::path& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open file: " + filename.string());
+    }
+    
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return buffer.str();
+}
+
+template <typename Engine>
+double measure(const std::string& source, int rounds, size_t& tokenCount) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; ++i) {
+        Engine engine(source);
+        tokenCount = engine.tokenize().size();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double>(elapsed).count() / rounds;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <examples_dir> [copies] [rounds]" << std::endl;
+        return 1;
+    }
+    
+    int copies = argc > 2 ? std::stoi(argv[2]) : 200;
+    int rounds = argc > 3 ? std::stoi(argv[3]) : 20;
+    
+    try {
+        std::string corpus;
+        for (const auto& entry : std::filesystem::directory_iterator(argv[1])) {
+            if (entry.path().extension() == ".ol") {
+                corpus += readFile(entry.path());
+                corpus += '\n';
+            }
+        }
+        
+        std::string source;
+        source.reserve(corpus.size() * copies);
+        for (int i = 0; i < copies; ++i) {
+            source += corpus;
+        }
+        
+        size_t handTokens = 0;
+        size_t dfaTokens = 0;
+        double hand = measure<olang::Lexer>(source, rounds, handTokens);
+        double dfa = measure<olang::DfaLexer>(source, rounds, dfaTokens);
+        double megabytes = source.size() / (1024.0 * 1024.0);
+        
+        std::cout << "Input: " << source.size() << " bytes, " << handTokens << " tokens" << std::endl;
+        std::cout << "Lexer:    " << hand * 1000 << " ms (" << megabytes / hand << " MB/s)" << std::endl;
+        std::cout << "DfaLexer: " << dfa * 1000 << " ms (" << megabytes / dfa << " MB/s)" << std::endl;
+        std::cout << "DFA: " << olang::DfaLexer::stateCount() << " states, "
+                  << olang::DfaLexer::byteClassCount() << " byte classes" << std::endl;
+        
+        if (handTokens != dfaTokens) {
+            std::cerr << "Token count mismatch: " << dfaTokens << std::endl;
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    
+    return 0;
+}
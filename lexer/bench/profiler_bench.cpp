@@ -0,0 +1,117 @@
+#include "declarations.h"
+#include "lexer.h"
+#include "profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#ifndef OLANG_EXAMPLES_DIR
+#error "OLANG_EXAMPLES_DIR must point to the directory with example .ol files"
+#endif
+
+// There is no O interpreter yet, so this measures the profiler hooks in a
+// minimal stack-machine dispatch loop running fib from tests/fibonacci.ol
+enum class Op { LOAD_ARG, PUSH, LESS, JUMP_IF_FALSE, SUB, ADD, CALL, RETURN };
+
+struct Instruction {
+    Op op;
+    long operand;
+};
+
+const std::vector<Instruction> FIB = {
+    {Op::LOAD_ARG, 0}, {Op::PUSH, 2}, {Op::LESS, 0}, {Op::JUMP_IF_FALSE, 6},
+    {Op::PUSH, 1}, {Op::RETURN, 0},
+    {Op::LOAD_ARG, 0}, {Op::PUSH, 1}, {Op::SUB, 0}, {Op::CALL, 0},
+    {Op::LOAD_ARG, 0}, {Op::PUSH, 2}, {Op::SUB, 0}, {Op::CALL, 0},
+    {Op::ADD, 0}, {Op::RETURN, 0},
+};
+
+long run(long argument, olang::Profiler* profiler, uint32_t method) {
+    long stack[8];
+    size_t top = 0;
+    size_t pc = 0;
+    uint64_t executed = 0;  // reported to the profiler at calls and returns
+    for (;;) {
+        executed++;
+        const Instruction& instruction = FIB[pc++];
+        switch (instruction.op) {
+            case Op::LOAD_ARG: stack[top++] = argument; break;
+            case Op::PUSH: stack[top++] = instruction.operand; break;
+            case Op::LESS: top--; stack[top - 1] = stack[top - 1] < stack[top]; break;
+            case Op::JUMP_IF_FALSE: if (!stack[--top]) pc = instruction.operand; break;
+            case Op::SUB: top--; stack[top - 1] -= stack[top]; break;
+            case Op::ADD: top--; stack[top - 1] += stack[top]; break;
+            case Op::CALL:
+                if (profiler) {
+                    profiler->tick(executed);
+                    executed = 0;
+                    profiler->enter(method);
+                }
+                stack[top - 1] = run(stack[top - 1], profiler, method);
+                if (profiler) profiler->leave();
+                break;
+            case Op::RETURN:
+                if (profiler) profiler->tick(executed);
+                return stack[top - 1];
+        }
+    }
+}
+
+double measure(long n, olang::Profiler* profiler, uint32_t method, long& result) {
+    auto start = std::chrono::steady_clock::now();
+    result = run(n, profiler, method);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double>(elapsed).count();
+}
+
+// Registers Main.fib at the position of its name token, as the engine will
+uint32_t addFib(olang::Profiler& profiler) {
+    std::ifstream file(std::string(OLANG_EXAMPLES_DIR) + "/fibonacci.ol");
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    olang::Lexer lexer(buffer.str());
+    std::vector<olang::Token> tokens = lexer.tokenize();
+    olang::DeclarationParser parser(tokens);
+    for (const olang::ClassDecl& decl : parser.parse()) {
+        for (const olang::MethodDecl& method : decl.methods) {
+            if (method.name == "fib") {
+                return profiler.addMethod(decl.name + ".fib", "fibonacci.ol", method.line, method.column);
+            }
+        }
+    }
+    throw std::runtime_error("fibonacci.ol declares no fib method");
+}
+
+int main(int argc, char* argv[]) {
+    long n = argc > 1 ? std::stol(argv[1]) : 30;
+    uint64_t interval = argc > 2 ? std::stoull(argv[2]) : 1000;
+    int rounds = argc > 3 ? std::stoi(argv[3]) : 40;
+
+    olang::Profiler profiler(interval);
+    uint32_t fib = addFib(profiler);
+
+    // Rounds alternate so that frequency scaling and other load hit both variants alike;
+    // the best round of each is compared
+    long result = 0;
+    double plain = 1e9;
+    double profiled = 1e9;
+    profiler.enter(fib);
+    for (int i = 0; i < rounds; ++i) {
+        plain = std::min(plain, measure(n, nullptr, 0, result));
+        profiled = std::min(profiled, measure(n, &profiler, fib, result));
+    }
+    profiler.leave();
+
+    const olang::ProfiledMethod& method = profiler.method(fib);
+    std::cout << method.name << " at " << method.file << ":" << method.line << ":" << method.column << std::endl;
+    std::cout << "fib(" << n << ") = " << result << ", sample every " << interval << " instructions" << std::endl;
+    std::cout << "without profiler: " << plain * 1000 << " ms" << std::endl;
+    std::cout << "with profiler:    " << profiled * 1000 << " ms (overhead "
+              << (profiled / plain - 1) * 100 << "%, " << profiler.sampleCount() << " samples)" << std::endl;
+
+    return 0;
+}
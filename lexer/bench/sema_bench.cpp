@@ -0,0 +1,72 @@
+#include "lexer.h"
+#include "semantic.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <sstream>
+
+// Synthetic project: classes in inheritance chains of the given depth,
+// spread over files, each with a few fields and methods calling each other
+std::vector<olang::SourceUnit> generateProject(size_t classes, size_t depth, size_t files) {
+    std::vector<std::ostringstream> sources(files);
+    for (size_t i = 0; i < classes; ++i) {
+        std::ostringstream& source = sources[i % files];
+        source << "class C" << i;
+        if (i % depth != 0) {
+            source << " extends C" << i - 1;
+        }
+        source << " is\n";
+        for (size_t f = 0; f < 4; ++f) {
+            source << "    var f" << i << "_" << f << ": Integer\n";
+        }
+        for (size_t m = 0; m < 6; ++m) {
+            source << "    method m" << i << "_" << m << "(x: Integer, y: List<Integer>) : Integer is\n"
+                   << "        var t: Integer = x.Plus(this.f" << i << "_" << m % 4 << ")\n"
+                   << "        while t.Greater(0) loop\n"
+                   << "            t := this.m" << i << "_" << (m + 1) % 6 << "(t.Minus(1), y)\n"
+                   << "        end\n"
+                   << "        return t\n"
+                   << "    end\n";
+        }
+        source << "end\n";
+    }
+    
+    std::vector<olang::SourceUnit> units;
+    for (size_t file = 0; file < files; ++file) {
+        olang::Lexer lexer(sources[file].str());
+        units.push_back(olang::SourceUnit{"gen" + std::to_string(file) + ".ol", lexer.tokenize()});
+    }
+    return units;
+}
+
+double measure(const std::vector<olang::SourceUnit>& units, olang::ThreadPool* pool, int rounds, size_t& errors) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; ++i) {
+        olang::SemanticAnalyzer analyzer(pool);
+        errors = analyzer.analyze(units).size();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double>(elapsed).count() / rounds;
+}
+
+int main(int argc, char* argv[]) {
+    size_t classes = argc > 1 ? std::stoul(argv[1]) : 5000;
+    size_t maxThreads = argc > 2 ? std::stoul(argv[2]) : std::max(1u, std::thread::hardware_concurrency());
+    int rounds = argc > 3 ? std::stoi(argv[3]) : 5;
+    
+    auto units = generateProject(classes, 4, 64);
+    
+    size_t errors = 0;
+    double serial = measure(units, nullptr, rounds, errors);
+    std::cout << "Classes: " << classes << ", errors: " << errors << std::endl;
+    std::cout << "serial:     " << serial * 1000 << " ms" << std::endl;
+    
+    for (size_t threads = 2; threads <= maxThreads; threads *= 2) {
+        olang::ThreadPool pool(threads);
+        double parallel = measure(units, &pool, rounds, errors);
+        std::cout << threads << " threads: " << parallel * 1000 << " ms (speedup "
+                  << serial / parallel << "x)" << std::endl;
+    }
+    
+    return 0;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "token.h"
+#include "constant_pool.h"
+#include "content_hash.h"
+#include "declarations.h"
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace olang {
+
+// Front-end output for one source file: tokens and the parsed class
+// declarations (the class interface). A lexer error is cached like a success,
+// so an unchanged broken file is not re-lexed either.
+struct LexResult {
+    std::vector<Token> tokens;
+    std::shared_ptr<ConstantPool> constants;
+    std::vector<ClassDecl> classes;         // empty if lexing failed
+    std::vector<ParseError> parseErrors;
+    bool failed = false;
+    std::string error;
+    size_t line = 0;
+    size_t column = 0;
+};
+
+// Thread-safe per-file cache of front-end output. An entry is reused while the
+// file's modification time and size are unchanged; otherwise the file is read
+// again and only re-lexed if its content hash differs.
+class CompileCache {
+private:
+    struct Entry {
+        std::filesystem::file_time_type modified;
+        uintmax_t size;
+        uint64_t hash;
+        std::shared_ptr<const LexResult> result;
+    };
+    
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+    std::atomic<size_t> hits_{0};
+    std::atomic<size_t> misses_{0};
+    
+public:
+    // Throws std::runtime_error if the file cannot be read
+    std::shared_ptr<const LexResult> lex(const std::string& path);
+    
+    void invalidate(const std::string& path);
+    void clear();
+    
+    size_t size() const;
+    size_t hits() const { return hits_; }
+    size_t misses() const { return misses_; }
+};
+
+}
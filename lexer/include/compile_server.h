@@ -0,0 +1,71 @@
+#pragma once
+
+#include "compile_cache.h"
+#include "thread_pool.h"
+#include <atomic>
+#include <chrono>
+#include <ostream>
+#include <string>
+
+namespace olang {
+
+// Compile daemon listening on a Unix-domain socket. It keeps a CompileCache
+// warm across requests and serves connections on a thread pool.
+//
+// Protocol: the client sends one request line and reads the reply until EOF.
+//   LEX <absolute path>[\t<display name>]
+//                         reply "OK\n" + lexer_demo stdout, or "FAIL\n" + stderr;
+//                         the display name (default: the path) heads the token dump
+//   CLASSES <absolute path>[\t<display name>]
+//                         reply "OK\n" + class and member signatures from the cached
+//                         declarations, or "FAIL\n" + lexer/parse errors
+//   STATS                 reply "OK\n" + cache counters
+//   SHUTDOWN              reply "OK\n", then the server stops accepting
+class CompileServer {
+private:
+    std::string socketPath_;
+    CompileCache cache_;
+    ThreadPool pool_;
+    int listener_;
+    int wakeRead_;                  // self-pipe that wakes serve() on stop()
+    int wakeWrite_;
+    std::atomic<bool> running_;
+    std::chrono::milliseconds ioTimeout_;
+    
+public:
+    CompileServer(std::string socketPath, size_t threads = 0);
+    ~CompileServer();
+    
+    CompileServer(const CompileServer&) = delete;
+    CompileServer& operator=(const CompileServer&) = delete;
+    
+    // Per-connection timeout: the request line must arrive within it, and each write of the
+    // reply must make progress within it; slower clients are dropped
+    void setIoTimeout(std::chrono::milliseconds timeout) { ioTimeout_ = timeout; }
+    
+    // Binds the socket; throws std::runtime_error on failure
+    void listen();
+    // Accepts connections until stop() or a SHUTDOWN request
+    void serve();
+    void stop();
+    
+    std::string handle(const std::string& request);
+    const CompileCache& cache() const { return cache_; }
+    
+private:
+    void handleConnection(int fd);
+};
+
+// Output of CLASSES: one line per class and member signature,
+// e.g. "class Cat extends Animal", "  method Speak() : String"
+void dumpClasses(std::ostream& out, const std::vector<ClassDecl>& classes);
+
+// Default socket: $OLEXER_SOCKET, $XDG_RUNTIME_DIR/olexer.sock, or
+// /tmp/olexer-<uid>/server.sock in a directory only this user can access.
+// Throws std::runtime_error if that directory exists but is not private.
+std::string defaultSocketPath();
+
+// Sends one request and stores the whole reply. Returns false if no server is reachable.
+bool sendRequest(const std::string& socketPath, const std::string& request, std::string& response);
+
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "token.h"
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace olang {
+
+// Deduplicated storage for literal values of one compilation.
+// Equal literals share one slot, so later stages can refer to a value by index.
+class ConstantPool {
+private:
+    // A deque never moves its elements, so the keys of strings_ can view the stored strings
+    // and a lookup of a known string allocates nothing
+    std::deque<TokenValue> constants_;
+    std::unordered_map<int64_t, uint32_t> integers_;
+    std::unordered_map<uint64_t, uint32_t> reals_;
+    std::unordered_map<std::string_view, uint32_t> strings_;
+    uint32_t booleans_[2] = {NO_CONSTANT, NO_CONSTANT};  // false, true
+
+public:
+    ConstantPool() = default;
+    // A copy would keep keys viewing the strings of the original
+    ConstantPool(const ConstantPool&) = delete;
+    ConstantPool& operator=(const ConstantPool&) = delete;
+
+    uint32_t intern(int64_t value);
+    uint32_t intern(double value);
+    uint32_t intern(std::string_view value);
+    uint32_t intern(bool value);
+    // Without this a string literal would pick intern(bool) over intern(std::string_view)
+    uint32_t intern(const char* value) { return intern(std::string_view(value)); }
+
+    const TokenValue& at(uint32_t index) const { return constants_.at(index); }
+    size_t size() const { return constants_.size(); }
+    bool empty() const { return constants_.empty(); }
+
+private:
+    uint32_t append(TokenValue value);
+};
+
+}
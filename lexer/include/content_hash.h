@@ -0,0 +1,11 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace olang {
+
+// 64-bit FNV-1a, used to detect files touched without changing content
+uint64_t contentHash(std::string_view content);
+
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "token.h"
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace olang {
+
+class ParseError : public std::runtime_error {
+private:
+    size_t line_;
+    size_t column_;
+
+public:
+    ParseError(const std::string& message, size_t line, size_t column)
+        : std::runtime_error(message), line_(line), column_(column) {}
+
+    size_t line() const { return line_; }
+    size_t column() const { return column_; }
+};
+
+// Class type as written in a declaration, e.g. List<Pair<K, V>> or Array[Integer]
+struct TypeRef {
+    std::string name;
+    std::vector<TypeRef> arguments;
+    size_t line = 0;
+    size_t column = 0;
+
+    std::string toString() const;
+};
+
+struct Parameter {
+    std::string name;
+    TypeRef type;
+};
+
+// Token range [begin, end) inside the token vector the declaration was parsed from
+struct BodyRange {
+    size_t begin = 0;
+    size_t end = 0;
+};
+
+struct FieldDecl {
+    std::string name;
+    std::optional<TypeRef> type;  // empty if only typing the initializer would tell
+    size_t line = 0;
+    size_t column = 0;
+};
+
+struct MethodDecl {
+    std::string name;
+    std::vector<Parameter> parameters;
+    std::optional<TypeRef> returnType;
+    std::optional<BodyRange> body;  // empty for forward declarations
+    size_t line = 0;
+    size_t column = 0;
+
+    // Name and parameter types, e.g. Plus(Integer); return type excluded
+    std::string signature() const;
+};
+
+struct ConstructorDecl {
+    std::vector<Parameter> parameters;
+    BodyRange body;
+    size_t line = 0;
+    size_t column = 0;
+
+    std::string signature() const;
+};
+
+struct ClassDecl {
+    std::string name;
+    std::vector<std::string> genericParameters;
+    std::optional<TypeRef> base;
+    std::vector<FieldDecl> fields;
+    std::vector<MethodDecl> methods;
+    std::vector<ConstructorDecl> constructors;
+    size_t line = 0;
+    size_t column = 0;
+};
+
+// Parses class declarations down to member signatures. Bodies and
+// initializers are only delimited; their statements are left to later passes.
+class DeclarationParser {
+private:
+    const std::vector<Token>& tokens_;
+    size_t current_;
+    std::vector<ParseError> errors_;
+
+public:
+    explicit DeclarationParser(const std::vector<Token>& tokens);
+
+    // A class with a syntax error is recorded in errors() and skipped
+    std::vector<ClassDecl> parse();
+    const std::vector<ParseError>& errors() const { return errors_; }
+
+    // Parses the type starting at tokens[pos] and moves pos past it
+    static TypeRef parseType(const std::vector<Token>& tokens, size_t& pos);
+
+private:
+    const Token& peek() const;
+    const Token& peekNext() const;
+    const Token& advance();
+    bool check(TokenType type) const;
+    bool match(TokenType type);
+    const Token& expect(TokenType type, const char* what);
+
+    ClassDecl classDeclaration();
+    void member(ClassDecl& decl);
+    FieldDecl field();
+    MethodDecl method();
+    ConstructorDecl constructor();
+    std::vector<Parameter> parameters();
+    TypeRef type();
+
+    BodyRange body();
+    BodyRange expression(bool allowEmpty);
+};
+
+}
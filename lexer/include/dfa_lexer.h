@@ -0,0 +1,44 @@
+#pragma once
+
+#include "token.h"
+#include "constant_pool.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace olang {
+
+// Table-driven lexer. Tokens are recognized by a minimized DFA generated at
+// compile time from token_spec.h; the inner loop does one table lookup per byte.
+// Produces the same tokens, positions and errors as Lexer.
+class DfaLexer {
+private:
+    std::string source_;
+    size_t current_;
+    size_t line_;
+    size_t column_;
+    std::shared_ptr<ConstantPool> constants_;
+
+public:
+    explicit DfaLexer(std::string source);
+    DfaLexer(std::string source, std::shared_ptr<ConstantPool> constants);
+
+    std::vector<Token> tokenize();
+    Token nextToken();
+
+    const ConstantPool& constants() const { return *constants_; }
+    std::shared_ptr<ConstantPool> sharedConstants() const { return constants_; }
+
+    static size_t stateCount();
+    static size_t byteClassCount();
+
+private:
+    void advanceTo(size_t end);
+
+    Token emit(TokenType type, size_t start, size_t end);
+    Token string(size_t start);
+    void skipLineComment();
+    void skipBlockComment();
+};
+
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "declarations.h"
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace olang {
+
+// Base class defined in another interface file, e.g. Animal from animals.oli
+struct InterfaceDependency {
+    std::string className;
+    std::string interface;
+
+    bool operator==(const InterfaceDependency& other) const {
+        return className == other.className && interface == other.interface;
+    }
+};
+
+// Precompiled class interface of one compiled unit (.oli): class names,
+// generic parameters, bases, fields and method/constructor signatures.
+// Bodies are not stored, only whether a method has one. Bases that come
+// from other interface files are listed as dependencies, so a missing
+// import can be named.
+//
+// Layout (all integers little-endian u32 unless noted):
+//   header   "OLIF", version, source hash (u64), class count,
+//            index offset, string table offset, string table size,
+//            dependency offset, dependency count
+//   index    per class, sorted by name: name offset, name length,
+//            record offset, generic parameter count
+//   deps     per dependency: class name and interface path, as string references
+//   records  one per class, strings as (offset, length) into the table
+//   strings  deduplicated UTF-8 bytes
+//
+// The file is memory-mapped. Looking up a class is a binary search over
+// the index; only the classes actually used are decoded.
+class InterfaceFile {
+private:
+    std::string path_;
+    const uint8_t* data_;
+    size_t size_;
+    void* mapping_;
+    std::vector<uint8_t> buffer_;  // used where mmap is unavailable
+
+public:
+    static constexpr uint32_t VERSION = 2;
+
+    static std::vector<uint8_t> encode(uint64_t sourceHash, const std::vector<ClassDecl>& classes,
+                                       const std::vector<InterfaceDependency>& dependencies = {});
+    // Throws std::runtime_error if the file cannot be written
+    static void write(const std::string& path, uint64_t sourceHash, const std::vector<ClassDecl>& classes,
+                      const std::vector<InterfaceDependency>& dependencies = {});
+
+    // Throws std::runtime_error if the file is missing or malformed
+    explicit InterfaceFile(const std::string& path);
+    ~InterfaceFile();
+
+    InterfaceFile(const InterfaceFile&) = delete;
+    InterfaceFile& operator=(const InterfaceFile&) = delete;
+
+    const std::string& path() const { return path_; }
+    uint64_t sourceHash() const;
+    size_t classCount() const;
+
+    std::string_view className(size_t index) const;
+    size_t genericCount(size_t index) const;
+    std::optional<size_t> find(std::string_view name) const;
+
+    std::vector<InterfaceDependency> dependencies() const;
+    // Interface that defines className, if this file depends on one
+    std::optional<std::string> dependency(std::string_view className) const;
+
+    ClassDecl decode(size_t index) const;
+
+private:
+    uint32_t u32(size_t offset) const;
+    std::string_view string(uint32_t offset, uint32_t length) const;
+    void validate() const;
+};
+
+// Rewrites interfacePath unless it already describes a source with this content
+// hash and the same dependencies. Returns true if the file was written.
+bool updateInterface(const std::string& interfacePath, uint64_t sourceHash, const std::vector<ClassDecl>& classes,
+                     const std::vector<InterfaceDependency>& dependencies = {});
+
+}
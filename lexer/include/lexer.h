@@ -1,6 +1,8 @@
 #pragma once
 
 #include "token.h"
+#include "constant_pool.h"
+#include <memory>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -27,15 +29,20 @@ private:
     size_t current_;
     size_t line_;
     size_t column_;
+    std::shared_ptr<ConstantPool> constants_;
     
     static const std::unordered_map<std::string, TokenType> keywords_;
     
 public:
     explicit Lexer(std::string source);
+    Lexer(std::string source, std::shared_ptr<ConstantPool> constants);
     
     std::vector<Token> tokenize();
     Token nextToken();
     
+    const ConstantPool& constants() const { return *constants_; }
+    std::shared_ptr<ConstantPool> sharedConstants() const { return constants_; }
+    
 private:
     char peek() const;
     char peekNext() const;
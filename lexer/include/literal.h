@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace olang {
+
+// Literal decoding shared by the lexer engines.
+// Numeric decoders throw LexerError at (line, column) on malformed or out-of-range input.
+int64_t decodeInteger(std::string_view text, size_t line, size_t column);
+double decodeReal(std::string_view text, size_t line, size_t column);
+
+// Decodes the body of a string literal (without quotes), resolving escapes
+std::string decodeString(std::string_view body);
+
+}
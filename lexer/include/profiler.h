@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace olang {
+
+// O method known to the profiler, located by the line and column of its name token
+struct ProfiledMethod {
+    std::string name;   // qualified, e.g. Main.fib
+    std::string file;
+    size_t line = 0;
+    size_t column = 0;
+};
+
+// Samples attributed to one method. A sample counts towards total once per
+// stack even if the method is on it several times (recursion).
+struct MethodProfile {
+    uint32_t method;
+    uint64_t self = 0;
+    uint64_t total = 0;
+};
+
+// Sampling profiler for the execution engine.
+//
+// The engine calls enter()/leave() around every O method call and tick() once
+// per dispatched instruction; every interval-th tick records the current
+// stack. Stacks are kept as a calling-context tree: enter() moves to a child
+// node, so a sample is a single counter increment and the stack is only
+// walked when the report is written. Counting ticks instead of using a timer
+// signal keeps samples deterministic and free of async-signal constraints.
+//
+// Not thread-safe: one profiler per interpreter thread.
+class Profiler {
+private:
+    struct Node {
+        Node(uint32_t method, uint32_t parent) : method(method), parent(parent) {}
+
+        uint32_t method;
+        uint32_t parent;
+        // The child entered last: a call site nearly always calls the same method again,
+        // so enter() usually finds it without touching children
+        uint32_t lastMethod = UINT32_MAX;
+        uint32_t lastChild = 0;
+        uint64_t samples = 0;
+        std::vector<uint32_t> children;
+    };
+
+    std::vector<ProfiledMethod> methods_;
+    std::vector<Node> nodes_;   // nodes_[0] is the root, outside any method
+    uint32_t current_;
+    uint64_t interval_;
+    uint64_t countdown_;
+    uint64_t samples_;
+
+    void enterChild(uint32_t method);
+    void sampleAfter(uint64_t instructions);
+
+public:
+    static constexpr uint32_t ROOT = 0;
+
+    // interval: dispatched instructions per sample; must be positive
+    explicit Profiler(uint64_t interval = 1000);
+
+    uint32_t addMethod(std::string name, std::string file, size_t line, size_t column);
+    const ProfiledMethod& method(uint32_t id) const { return methods_.at(id); }
+    size_t methodCount() const { return methods_.size(); }
+
+    // enter()/leave() run on every O call, so their fast path is inline
+    void enter(uint32_t method) {
+        Node& node = nodes_[current_];
+        if (node.lastMethod == method) {
+            current_ = node.lastChild;
+            return;
+        }
+        enterChild(method);
+    }
+    // Precondition: a method is active (asserted in debug builds only)
+    void leave() {
+        assert(current_ != ROOT && "Profiler::leave without a matching enter");
+        current_ = nodes_[current_].parent;
+    }
+    size_t depth() const;
+
+    void tick() {
+        if (--countdown_ == 0) {
+            sample();
+        }
+    }
+    // Same as instructions calls of tick(), for an engine that counts dispatched
+    // instructions in a local and reports them at calls, returns and back-edges.
+    // Decrementing a member on every instruction is a store the dispatch loop
+    // waits on, which costs more than all the enter()/leave() bookkeeping.
+    void tick(uint64_t instructions) {
+        if (instructions < countdown_) {
+            countdown_ -= instructions;
+            return;
+        }
+        sampleAfter(instructions);
+    }
+    // Records the current stack immediately
+    void sample();
+
+    uint64_t sampleCount() const { return samples_; }
+
+    // Sorted by self, then total samples, descending; methods never sampled are omitted
+    std::vector<MethodProfile> profile() const;
+
+    // One line per distinct stack, root first: "Main.this;Main.fib;Main.pred 17".
+    // Frames carry no location, so flamegraph.pl merges calls of one method.
+    void writeFolded(std::ostream& out) const;
+    // Self/total table with the declaration site of each method
+    void writeTable(std::ostream& out) const;
+};
+
+}
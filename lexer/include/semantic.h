@@ -0,0 +1,98 @@
+#pragma once
+
+#include "declarations.h"
+#include "interface_file.h"
+#include "thread_pool.h"
+#include <deque>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace olang {
+
+struct Diagnostic {
+    std::string file;
+    size_t line;
+    size_t column;
+    std::string message;
+};
+
+std::ostream& operator<<(std::ostream& os, const Diagnostic& diagnostic);
+
+struct SourceUnit {
+    std::string file;
+    std::vector<Token> tokens;
+};
+
+// Library classes are present in every program without a declaration
+bool isLibraryClass(const std::string& name);
+
+// A class after declaration collection. Only the analyzer writes to it, one
+// inheritance level at a time; afterwards it is shared read-only.
+struct ClassInfo {
+    const ClassDecl* decl = nullptr;
+    size_t unit = 0;
+    bool imported = false;      // decoded from an interface file, not checked again
+    const InterfaceFile* source = nullptr;  // the interface file of an imported class
+    int base = -1;              // index of the user-defined base class
+    bool opaqueBase = false;    // extends a library class or a missing import; members not modelled
+    size_t depth = 0;           // distance from the root of its inheritance chain
+
+    // Own and inherited members; overrides replace the inherited entry
+    std::unordered_map<std::string, std::vector<const MethodDecl*>> methods;
+    std::unordered_set<std::string> fields;
+};
+
+// Checks a whole program (all units share one class namespace).
+//
+// Declarations are collected serially; inheritance is resolved level by level
+// in topological order; class bodies are then checked in parallel, one work
+// unit per class. Diagnostics are sorted by unit, line and column, so the
+// output does not depend on the number of threads.
+//
+// Classes from imported interface files are only decoded when a program
+// class extends them; type references just read their index entry.
+class SemanticAnalyzer {
+private:
+    ThreadPool* pool_;
+    std::vector<const InterfaceFile*> imports_;
+    std::vector<std::vector<ClassDecl>> declarations_;
+    std::deque<ClassDecl> importedDeclarations_;
+    std::vector<ClassInfo> classes_;
+    std::unordered_map<std::string, size_t> classIndex_;
+
+public:
+    // Without a pool everything runs on the calling thread. The calling
+    // thread blocks on the pool, so it must not be one of the pool's workers.
+    explicit SemanticAnalyzer(ThreadPool* pool = nullptr);
+
+    // The interface file must outlive the analyzer; earlier imports win on name clashes
+    void addImport(const InterfaceFile& file) { imports_.push_back(&file); }
+
+    std::vector<Diagnostic> analyze(const std::vector<SourceUnit>& units);
+
+    const std::vector<ClassDecl>& declarations(size_t unit) const { return declarations_.at(unit); }
+    // Imported base classes of the unit's classes, with the interface each came from
+    std::vector<InterfaceDependency> importDependencies(size_t unit) const;
+
+    const ClassInfo* findClass(const std::string& name) const;
+    size_t classCount() const { return classes_.size(); }
+
+private:
+    template <typename F>
+    void parallelFor(size_t count, F body);
+
+    int importClass(const std::string& name);
+    std::optional<size_t> findImport(const std::string& name) const;
+    std::vector<std::vector<size_t>> resolveInheritance(std::vector<std::vector<Diagnostic>>& diagnostics);
+    void reportMissingImports(std::vector<std::vector<Diagnostic>>& diagnostics);
+    void collectMembers(size_t index, std::vector<Diagnostic>& diagnostics);
+    void checkClass(size_t index, const std::vector<Token>& tokens, std::vector<Diagnostic>& diagnostics) const;
+    void checkType(const TypeRef& type, const ClassInfo& info, std::vector<Diagnostic>& diagnostics) const;
+    void checkBody(const BodyRange& body, const std::vector<Token>& tokens, const ClassInfo& info,
+                   std::vector<Diagnostic>& diagnostics) const;
+};
+
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <variant>
 #include <ostream>
@@ -51,18 +52,23 @@ enum class TokenType {
 
 using TokenValue = std::variant<std::monostate, int64_t, double, bool, std::string>;
 
+constexpr uint32_t NO_CONSTANT = UINT32_MAX;
+
 struct Token {
     TokenType type;
     std::string lexeme;
     TokenValue value;
     size_t line;
     size_t column;
+    uint32_t constant;  // slot in the ConstantPool for literals, NO_CONSTANT otherwise
     
     Token(TokenType type, std::string lexeme, size_t line, size_t column)
-        : type(type), lexeme(std::move(lexeme)), value(std::monostate{}), line(line), column(column) {}
+        : type(type), lexeme(std::move(lexeme)), value(std::monostate{}), line(line), column(column),
+          constant(NO_CONSTANT) {}
     
     Token(TokenType type, std::string lexeme, TokenValue value, size_t line, size_t column)
-        : type(type), lexeme(std::move(lexeme)), value(std::move(value)), line(line), column(column) {}
+        : type(type), lexeme(std::move(lexeme)), value(std::move(value)), line(line), column(column),
+          constant(NO_CONSTANT) {}
 };
 
 std::string tokenTypeToString(TokenType type);
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "lexer.h"
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace olang {
+
+// Output format of lexer_demo, shared with the compile server
+void dumpTokens(std::ostream& os, const std::string& filename, const std::vector<Token>& tokens);
+void dumpLexerError(std::ostream& os, const std::string& message, size_t line, size_t column);
+
+}
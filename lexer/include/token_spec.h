@@ -0,0 +1,132 @@
+#pragma once
+
+#include "token.h"
+#include <cstdint>
+
+// Declarative token specification for the table-driven lexer (DfaLexer).
+// The transition table is built from this file at compile time, so new
+// operators or keywords are added here and nowhere else.
+
+namespace olang::spec {
+
+// What the lexer does once the longest match ends in an accepting state
+enum class Action : uint8_t {
+    NONE,
+    EMIT,
+    SKIP_WHITESPACE,
+    STRING,         // opening quote, the body is scanned outside the DFA
+    LINE_COMMENT,
+    BLOCK_COMMENT   // comments nest, so they are not regular either
+};
+
+struct FixedRule {
+    const char* spelling;
+    Action action;
+    TokenType type;
+};
+
+// Exact spellings. They take priority over patterns of the same length,
+// which is how keywords win over identifiers.
+inline constexpr FixedRule FIXED_RULES[] = {
+    {"class", Action::EMIT, TokenType::CLASS},
+    {"is", Action::EMIT, TokenType::IS},
+    {"end", Action::EMIT, TokenType::END},
+    {"extends", Action::EMIT, TokenType::EXTENDS},
+    {"var", Action::EMIT, TokenType::VAR},
+    {"method", Action::EMIT, TokenType::METHOD},
+    {"this", Action::EMIT, TokenType::THIS},
+    {"if", Action::EMIT, TokenType::IF},
+    {"then", Action::EMIT, TokenType::THEN},
+    {"else", Action::EMIT, TokenType::ELSE},
+    {"while", Action::EMIT, TokenType::WHILE},
+    {"loop", Action::EMIT, TokenType::LOOP},
+    {"return", Action::EMIT, TokenType::RETURN},
+    {"true", Action::EMIT, TokenType::TRUE},
+    {"false", Action::EMIT, TokenType::FALSE},
+    {"base", Action::EMIT, TokenType::BASE},
+
+    {":", Action::EMIT, TokenType::COLON},
+    {":=", Action::EMIT, TokenType::ASSIGN},
+    {"=", Action::EMIT, TokenType::EQUAL},
+    {"=>", Action::EMIT, TokenType::ARROW},
+    {".", Action::EMIT, TokenType::DOT},
+    {",", Action::EMIT, TokenType::COMMA},
+    {"(", Action::EMIT, TokenType::LPAREN},
+    {")", Action::EMIT, TokenType::RPAREN},
+    {"[", Action::EMIT, TokenType::LBRACKET},
+    {"]", Action::EMIT, TokenType::RBRACKET},
+    {"{", Action::EMIT, TokenType::LBRACE},
+    {"}", Action::EMIT, TokenType::RBRACE},
+    {"<", Action::EMIT, TokenType::LANGLE},
+    {">", Action::EMIT, TokenType::RANGLE},
+
+    {"\"", Action::STRING, TokenType::STRING_LITERAL},
+    {"//", Action::LINE_COMMENT, TokenType::INVALID},
+    {"/*", Action::BLOCK_COMMENT, TokenType::INVALID}
+};
+
+// Character sets the patterns below are written in
+enum class CharSet : uint8_t {
+    NONE,
+    ALPHA,
+    DIGIT,
+    DOT,
+    SPACE
+};
+
+constexpr CharSet charSetOf(unsigned char c) {
+    if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_') return CharSet::ALPHA;
+    if (c >= '0' && c <= '9') return CharSet::DIGIT;
+    if (c == '.') return CharSet::DOT;
+    if (c == ' ' || c == '\t' || c == '\r' || c == '\n') return CharSet::SPACE;
+    return CharSet::NONE;
+}
+
+// Hand-written automaton for the non-literal token classes:
+//   identifier  ALPHA (ALPHA | DIGIT)*
+//   integer     DIGIT+
+//   real        DIGIT+ DOT DIGIT+
+//   whitespace  SPACE+
+enum class Pattern : uint8_t {
+    START,
+    IDENT,
+    INT,
+    INT_DOT,
+    REAL,
+    SPACE,
+    NONE
+};
+
+struct PatternEdge {
+    Pattern from;
+    CharSet on;
+    Pattern to;
+};
+
+inline constexpr PatternEdge PATTERN_EDGES[] = {
+    {Pattern::START, CharSet::ALPHA, Pattern::IDENT},
+    {Pattern::START, CharSet::DIGIT, Pattern::INT},
+    {Pattern::START, CharSet::SPACE, Pattern::SPACE},
+    {Pattern::IDENT, CharSet::ALPHA, Pattern::IDENT},
+    {Pattern::IDENT, CharSet::DIGIT, Pattern::IDENT},
+    {Pattern::INT, CharSet::DIGIT, Pattern::INT},
+    {Pattern::INT, CharSet::DOT, Pattern::INT_DOT},
+    {Pattern::INT_DOT, CharSet::DIGIT, Pattern::REAL},
+    {Pattern::REAL, CharSet::DIGIT, Pattern::REAL},
+    {Pattern::SPACE, CharSet::SPACE, Pattern::SPACE}
+};
+
+struct PatternAccept {
+    Pattern state;
+    Action action;
+    TokenType type;
+};
+
+inline constexpr PatternAccept PATTERN_ACCEPTS[] = {
+    {Pattern::IDENT, Action::EMIT, TokenType::IDENTIFIER},
+    {Pattern::INT, Action::EMIT, TokenType::INTEGER_LITERAL},
+    {Pattern::REAL, Action::EMIT, TokenType::REAL_LITERAL},
+    {Pattern::SPACE, Action::SKIP_WHITESPACE, TokenType::INVALID}
+};
+
+}
@@ -0,0 +1,125 @@
+#include "compile_server.h"
+#include "lexer.h"
+#include "token_dump.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+std::string readFile(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open file: " + filename);
+    }
+    
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return buffer.str();
+}
+
+// Same as lexer_demo (or the CLASSES reply); used when no server is running
+int lexInProcess(const std::string& filename, bool classes) {
+    try {
+        std::string source = readFile(filename);
+        olang::Lexer lexer(source);
+        
+        std::vector<olang::Token> tokens = lexer.tokenize();
+        if (!classes) {
+            olang::dumpTokens(std::cout, filename, tokens);
+            return 0;
+        }
+        
+        olang::DeclarationParser parser(tokens);
+        std::vector<olang::ClassDecl> declarations = parser.parse();
+        for (const olang::ParseError& e : parser.errors()) {
+            std::cerr << filename << ":" << e.line() << ":" << e.column() << ": error: " << e.what() << std::endl;
+        }
+        olang::dumpClasses(parser.errors().empty() ? std::cout : std::cerr, declarations);
+        return parser.errors().empty() ? 0 : 1;
+        
+    } catch (const olang::LexerError& e) {
+        olang::dumpLexerError(std::cerr, e.what(), e.line(), e.column());
+        return 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    std::string socketPath;
+    std::string request;
+    std::string filename;
+    bool classes = false;
+    
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--socket") == 0 && i + 1 < argc) {
+            socketPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--stats") == 0) {
+            request = "STATS";
+        } else if (std::strcmp(argv[i], "--shutdown") == 0) {
+            request = "SHUTDOWN";
+        } else if (std::strcmp(argv[i], "--classes") == 0) {
+            classes = true;
+        } else {
+            filename = argv[i];
+        }
+    }
+    
+    if (request.empty() && filename.empty()) {
+        std::cerr << "Usage: " << argv[0] << " [--socket <path>] [--classes] <source_file.ol> | --stats | --shutdown" << std::endl;
+        return 1;
+    }
+    
+    if (request.empty()) {
+        // The server has a different working directory, so it gets the absolute
+        // path to read and the name as given to print
+        std::error_code ec;
+        std::filesystem::path absolute = std::filesystem::absolute(filename, ec);
+        std::string path = ec ? filename : absolute.string();
+        // The request line cannot frame tabs or newlines
+        if ((path + filename).find_first_of("\t\n") != std::string::npos) {
+            return lexInProcess(filename, classes);
+        }
+        request = (classes ? "CLASSES " : "LEX ") + path + "\t" + filename;
+    }
+    
+    std::string response;
+    try {
+        if (socketPath.empty()) {
+            try {
+                socketPath = olang::defaultSocketPath();
+            } catch (const std::runtime_error&) {
+                // No trustworthy socket location means no server to ask
+                if (!filename.empty()) {
+                    return lexInProcess(filename, classes);
+                }
+                throw;
+            }
+        }
+        if (!olang::sendRequest(socketPath, request, response)) {
+            if (filename.empty()) {
+                std::cerr << "Error: No server on " << socketPath << std::endl;
+                return 1;
+            }
+            return lexInProcess(filename, classes);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    
+    size_t newline = response.find('\n');
+    std::string status = response.substr(0, newline);
+    std::string body = newline == std::string::npos ? "" : response.substr(newline + 1);
+    
+    if (status == "OK") {
+        std::cout << body;
+        return 0;
+    }
+    std::cerr << body;
+    return 1;
+}
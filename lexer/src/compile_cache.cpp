@@ -0,0 +1,101 @@
+#include "compile_cache.h"
+#include "lexer.h"
+#include <fstream>
+#include <mutex>
+#include <sstream>
+
+namespace olang {
+
+namespace {
+
+std::string readSource(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open file: " + path);
+    }
+    
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return buffer.str();
+}
+
+std::shared_ptr<const LexResult> lexSource(std::string source) {
+    auto result = std::make_shared<LexResult>();
+    result->constants = std::make_shared<ConstantPool>();
+    
+    try {
+        Lexer lexer(std::move(source), result->constants);
+        result->tokens = lexer.tokenize();
+    } catch (const LexerError& e) {
+        result->failed = true;
+        result->error = e.what();
+        result->line = e.line();
+        result->column = e.column();
+        return result;
+    }
+    
+    DeclarationParser parser(result->tokens);
+    result->classes = parser.parse();
+    result->parseErrors = parser.errors();
+    return result;
+}
+
+}
+
+std::shared_ptr<const LexResult> CompileCache::lex(const std::string& path) {
+    std::error_code ec;
+    auto modified = std::filesystem::last_write_time(path, ec);
+    uintmax_t size = ec ? 0 : std::filesystem::file_size(path, ec);
+    if (ec) {
+        throw std::runtime_error("Could not open file: " + path);
+    }
+    
+    uint64_t previousHash = 0;
+    std::shared_ptr<const LexResult> previous;
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = entries_.find(path);
+        if (it != entries_.end()) {
+            if (it->second.modified == modified && it->second.size == size) {
+                hits_++;
+                return it->second.result;
+            }
+            previousHash = it->second.hash;
+            previous = it->second.result;
+        }
+    }
+    
+    // Lexing happens outside the lock so other files are served meanwhile
+    std::string source = readSource(path);
+    uint64_t hash = contentHash(source);
+    
+    std::shared_ptr<const LexResult> result;
+    if (previous && previousHash == hash) {
+        hits_++;
+        result = previous;
+    } else {
+        misses_++;
+        result = lexSource(std::move(source));
+    }
+    
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    entries_[path] = Entry{modified, size, hash, result};
+    return result;
+}
+
+void CompileCache::invalidate(const std::string& path) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    entries_.erase(path);
+}
+
+void CompileCache::clear() {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    entries_.clear();
+}
+
+size_t CompileCache::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return entries_.size();
+}
+
+}
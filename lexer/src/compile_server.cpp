@@ -0,0 +1,326 @@
+#include "compile_server.h"
+#include "token_dump.h"
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sstream>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace olang {
+
+namespace {
+
+sockaddr_un socketAddress(const std::string& path) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("Socket path too long: " + path);
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    return address;
+}
+
+bool writeAll(int fd, const std::string& data) {
+    size_t written = 0;
+    while (written < data.size()) {
+        ssize_t n = ::send(fd, data.data() + written, data.size() - written, MSG_NOSIGNAL);
+        if (n <= 0) {
+            return false;
+        }
+        written += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// "CLASSES " + path + '\t' + display name
+constexpr size_t MAX_REQUEST = 2 * PATH_MAX + 16;
+
+// Reads one request line without the '\n'. Fails on EOF, error, a line longer than
+// MAX_REQUEST or the deadline passing before the newline: SO_RCVTIMEO alone bounds
+// each recv(), so a client trickling bytes could otherwise hold the worker forever.
+bool readLine(int fd, std::string& line, std::chrono::steady_clock::time_point deadline) {
+    std::string data;
+    char buffer[4096];
+    for (;;) {
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now());
+        if (remaining.count() <= 0) {
+            return false;
+        }
+        pollfd ready{fd, POLLIN, 0};
+        int polled = ::poll(&ready, 1, static_cast<int>(remaining.count()));
+        if (polled < 0 && errno == EINTR) {
+            continue;
+        }
+        if (polled <= 0) {
+            return false;
+        }
+        
+        ssize_t n = ::recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) {
+            return false;
+        }
+        data.append(buffer, static_cast<size_t>(n));
+        size_t newline = data.find('\n');
+        if (newline != std::string::npos && newline <= MAX_REQUEST) {
+            data.resize(newline);
+            line = std::move(data);
+            return true;
+        }
+        if (data.size() > MAX_REQUEST) {
+            return false;
+        }
+    }
+}
+
+std::string readAll(int fd) {
+    std::string data;
+    char buffer[4096];
+    for (;;) {
+        ssize_t n = ::recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) {
+            break;
+        }
+        data.append(buffer, static_cast<size_t>(n));
+    }
+    return data;
+}
+
+void setNonBlocking(int fd, bool enabled) {
+    int flags = ::fcntl(fd, F_GETFL, 0);
+    ::fcntl(fd, F_SETFL, enabled ? flags | O_NONBLOCK : flags & ~O_NONBLOCK);
+}
+
+}
+
+CompileServer::CompileServer(std::string socketPath, size_t threads)
+    : socketPath_(std::move(socketPath)), pool_(threads), listener_(-1), wakeRead_(-1), wakeWrite_(-1),
+      running_(false), ioTimeout_(std::chrono::seconds(5)) {}
+
+CompileServer::~CompileServer() {
+    stop();
+    if (listener_ >= 0) {
+        ::close(listener_);
+        ::unlink(socketPath_.c_str());
+    }
+    if (wakeRead_ >= 0) {
+        ::close(wakeRead_);
+        ::close(wakeWrite_);
+    }
+}
+
+void CompileServer::listen() {
+    sockaddr_un address = socketAddress(socketPath_);
+    
+    // A socket file left by a crashed server would make bind fail
+    std::string unused;
+    if (sendRequest(socketPath_, "STATS", unused)) {
+        throw std::runtime_error("Server already running on " + socketPath_);
+    }
+    ::unlink(socketPath_.c_str());
+    
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        throw std::runtime_error("Could not create socket: " + std::string(std::strerror(errno)));
+    }
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+        ::listen(fd, SOMAXCONN) < 0) {
+        std::string reason = std::strerror(errno);
+        ::close(fd);
+        throw std::runtime_error("Could not listen on " + socketPath_ + ": " + reason);
+    }
+    
+    // stop() writes to this pipe to wake the poll() in serve(); shutdown() on a
+    // listening socket only does that on Linux
+    int wake[2];
+    if (::pipe(wake) < 0) {
+        std::string reason = std::strerror(errno);
+        ::close(fd);
+        throw std::runtime_error("Could not create pipe: " + reason);
+    }
+    setNonBlocking(wake[1], true);
+    setNonBlocking(fd, true);
+    
+    listener_ = fd;
+    wakeRead_ = wake[0];
+    wakeWrite_ = wake[1];
+    running_ = true;
+}
+
+void CompileServer::serve() {
+    while (running_) {
+        pollfd fds[2] = {{listener_, POLLIN, 0}, {wakeRead_, POLLIN, 0}};
+        if (::poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        if (fds[1].revents != 0 || !running_) {
+            break;
+        }
+        
+        int client = ::accept(listener_, nullptr, nullptr);
+        if (client < 0) {
+            // The client may have gone away between poll() and accept()
+            if (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK || errno == ECONNABORTED) {
+                continue;
+            }
+            break;
+        }
+        // BSDs pass O_NONBLOCK on from the listener
+        setNonBlocking(client, false);
+        
+        // A client that stalls must not hold a pool worker forever
+        timeval timeout{};
+        timeout.tv_sec = static_cast<time_t>(ioTimeout_.count() / 1000);
+        timeout.tv_usec = static_cast<suseconds_t>(ioTimeout_.count() % 1000 * 1000);
+        ::setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        ::setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+        pool_.submit([this, client] { handleConnection(client); });
+    }
+}
+
+void CompileServer::stop() {
+    if (running_.exchange(false) && wakeWrite_ >= 0) {
+        char byte = 0;
+        [[maybe_unused]] ssize_t written = ::write(wakeWrite_, &byte, 1);
+    }
+}
+
+void CompileServer::handleConnection(int fd) {
+    std::string request;
+    if (readLine(fd, request, std::chrono::steady_clock::now() + ioTimeout_)) {
+        writeAll(fd, handle(request));
+    }
+    ::close(fd);
+}
+
+std::string CompileServer::handle(const std::string& request) {
+    std::istringstream in(request);
+    std::string command;
+    in >> command;
+    
+    if (command == "LEX" || command == "CLASSES") {
+        std::string path;
+        std::getline(in >> std::ws, path);
+        std::string name = path;
+        size_t tab = path.find('\t');
+        if (tab != std::string::npos) {
+            name = path.substr(tab + 1);
+            path.resize(tab);
+        }
+        
+        std::ostringstream out;
+        try {
+            auto result = cache_.lex(path);
+            if (result->failed) {
+                dumpLexerError(out, result->error, result->line, result->column);
+                return "FAIL\n" + out.str();
+            }
+            if (command == "LEX") {
+                dumpTokens(out, name, result->tokens);
+                return "OK\n" + out.str();
+            }
+            for (const ParseError& e : result->parseErrors) {
+                out << name << ":" << e.line() << ":" << e.column() << ": error: " << e.what() << "\n";
+            }
+            dumpClasses(out, result->classes);
+            return (result->parseErrors.empty() ? "OK\n" : "FAIL\n") + out.str();
+        } catch (const std::exception& e) {
+            return "FAIL\nError: " + std::string(e.what()) + "\n";
+        }
+    }
+    
+    if (command == "STATS") {
+        std::ostringstream out;
+        out << "files: " << cache_.size() << "\n"
+            << "hits: " << cache_.hits() << "\n"
+            << "misses: " << cache_.misses() << "\n"
+            << "threads: " << pool_.size() << "\n";
+        return "OK\n" + out.str();
+    }
+    
+    if (command == "SHUTDOWN") {
+        stop();
+        return "OK\n";
+    }
+    
+    return "FAIL\nError: Unknown request '" + command + "'\n";
+}
+
+void dumpClasses(std::ostream& out, const std::vector<ClassDecl>& classes) {
+    for (const ClassDecl& decl : classes) {
+        out << "class " << decl.name;
+        for (size_t i = 0; i < decl.genericParameters.size(); ++i) {
+            out << (i == 0 ? "<" : ", ") << decl.genericParameters[i];
+        }
+        if (!decl.genericParameters.empty()) out << ">";
+        if (decl.base) out << " extends " << decl.base->toString();
+        out << "\n";
+        
+        for (const FieldDecl& field : decl.fields) {
+            out << "  var " << field.name;
+            if (field.type) out << " : " << field.type->toString();
+            out << "\n";
+        }
+        for (const MethodDecl& method : decl.methods) {
+            out << "  method " << method.signature();
+            if (method.returnType) out << " : " << method.returnType->toString();
+            out << "\n";
+        }
+        for (const ConstructorDecl& constructor : decl.constructors) {
+            out << "  " << constructor.signature() << "\n";
+        }
+    }
+}
+
+std::string defaultSocketPath() {
+    if (const char* path = std::getenv("OLEXER_SOCKET")) {
+        return path;
+    }
+    // Only the user can create files here, so nobody can squat the socket
+    if (const char* runtime = std::getenv("XDG_RUNTIME_DIR"); runtime && *runtime) {
+        return std::string(runtime) + "/olexer.sock";
+    }
+    
+    // Fallback: a private directory in /tmp that must belong to us
+    std::string directory = "/tmp/olexer-" + std::to_string(::getuid());
+    if (::mkdir(directory.c_str(), 0700) < 0 && errno != EEXIST) {
+        throw std::runtime_error("Could not create " + directory + ": " + std::strerror(errno));
+    }
+    struct stat info;
+    if (::lstat(directory.c_str(), &info) < 0 || !S_ISDIR(info.st_mode) || info.st_uid != ::getuid() ||
+        (info.st_mode & 0077) != 0) {
+        throw std::runtime_error("Refusing to use " + directory + ": not a private directory owned by this user");
+    }
+    return directory + "/server.sock";
+}
+
+bool sendRequest(const std::string& socketPath, const std::string& request, std::string& response) {
+    sockaddr_un address = socketAddress(socketPath);
+    
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return false;
+    }
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+        !writeAll(fd, request + "\n")) {
+        ::close(fd);
+        return false;
+    }
+    
+    response = readAll(fd);
+    ::close(fd);
+    return true;
+}
+
+}
@@ -0,0 +1,54 @@
+#include "constant_pool.h"
+#include <cstring>
+
+namespace olang {
+
+uint32_t ConstantPool::intern(int64_t value) {
+    auto it = integers_.find(value);
+    if (it != integers_.end()) {
+        return it->second;
+    }
+    uint32_t index = append(value);
+    integers_.emplace(value, index);
+    return index;
+}
+
+uint32_t ConstantPool::intern(double value) {
+    // Keyed by bit pattern so that 0.0 and -0.0 stay distinct
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    auto it = reals_.find(bits);
+    if (it != reals_.end()) {
+        return it->second;
+    }
+    uint32_t index = append(value);
+    reals_.emplace(bits, index);
+    return index;
+}
+
+uint32_t ConstantPool::intern(std::string_view value) {
+    auto it = strings_.find(value);
+    if (it != strings_.end()) {
+        return it->second;
+    }
+    uint32_t index = append(std::string(value));
+    strings_.emplace(std::get<std::string>(constants_.back()), index);
+    return index;
+}
+
+uint32_t ConstantPool::intern(bool value) {
+    uint32_t& slot = booleans_[value ? 1 : 0];
+    if (slot == NO_CONSTANT) {
+        slot = append(value);
+    }
+    return slot;
+}
+
+uint32_t ConstantPool::append(TokenValue value) {
+    uint32_t index = static_cast<uint32_t>(constants_.size());
+    constants_.push_back(std::move(value));
+    return index;
+}
+
+}
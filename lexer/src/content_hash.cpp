@@ -0,0 +1,14 @@
+#include "content_hash.h"
+
+namespace olang {
+
+uint64_t contentHash(std::string_view content) {
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : content) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+}
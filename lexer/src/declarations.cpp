@@ -0,0 +1,352 @@
+#include "declarations.h"
+#include <sstream>
+
+namespace olang {
+
+namespace {
+
+[[noreturn]] void unexpected(const Token& token, const char* what) {
+    std::ostringstream oss;
+    oss << "Expected " << what << ", found ";
+    if (token.type == TokenType::END_OF_FILE) {
+        oss << "end of file";
+    } else {
+        oss << "'" << token.lexeme << "'";
+    }
+    throw ParseError(oss.str(), token.line, token.column);
+}
+
+const char* literalType(TokenType type) {
+    switch (type) {
+        case TokenType::INTEGER_LITERAL: return "Integer";
+        case TokenType::REAL_LITERAL: return "Real";
+        case TokenType::STRING_LITERAL: return "String";
+        case TokenType::TRUE:
+        case TokenType::FALSE: return "Boolean";
+        default: return nullptr;
+    }
+}
+
+std::string parameterList(const std::vector<Parameter>& parameters) {
+    std::string result = "(";
+    for (size_t i = 0; i < parameters.size(); ++i) {
+        if (i > 0) result += ", ";
+        result += parameters[i].type.toString();
+    }
+    return result + ")";
+}
+
+}
+
+std::string TypeRef::toString() const {
+    if (arguments.empty()) {
+        return name;
+    }
+    std::string result = name + "<";
+    for (size_t i = 0; i < arguments.size(); ++i) {
+        if (i > 0) result += ", ";
+        result += arguments[i].toString();
+    }
+    return result + ">";
+}
+
+std::string MethodDecl::signature() const {
+    return name + parameterList(parameters);
+}
+
+std::string ConstructorDecl::signature() const {
+    return "this" + parameterList(parameters);
+}
+
+DeclarationParser::DeclarationParser(const std::vector<Token>& tokens)
+    : tokens_(tokens), current_(0) {}
+
+std::vector<ClassDecl> DeclarationParser::parse() {
+    std::vector<ClassDecl> classes;
+    while (!check(TokenType::END_OF_FILE)) {
+        size_t start = current_;
+        try {
+            classes.push_back(classDeclaration());
+        } catch (const ParseError& e) {
+            errors_.push_back(e);
+            // Resume at the next class declaration
+            if (current_ == start) {
+                advance();
+            }
+            while (!check(TokenType::CLASS) && !check(TokenType::END_OF_FILE)) {
+                advance();
+            }
+        }
+    }
+    return classes;
+}
+
+TypeRef DeclarationParser::parseType(const std::vector<Token>& tokens, size_t& pos) {
+    auto at = [&tokens](size_t index) -> const Token& {
+        return tokens[index < tokens.size() ? index : tokens.size() - 1];
+    };
+
+    const Token& name = at(pos);
+    if (name.type != TokenType::IDENTIFIER) {
+        unexpected(name, "type name");
+    }
+    pos++;
+
+    TypeRef ref;
+    ref.name = name.lexeme;
+    ref.line = name.line;
+    ref.column = name.column;
+
+    // Generic arguments: List<T> as in the examples, Array[T] as in the specification
+    TokenType open = at(pos).type;
+    if (open == TokenType::LANGLE || open == TokenType::LBRACKET) {
+        TokenType close = open == TokenType::LANGLE ? TokenType::RANGLE : TokenType::RBRACKET;
+        pos++;
+        ref.arguments.push_back(parseType(tokens, pos));
+        while (at(pos).type == TokenType::COMMA) {
+            pos++;
+            ref.arguments.push_back(parseType(tokens, pos));
+        }
+        if (at(pos).type != close) {
+            unexpected(at(pos), close == TokenType::RANGLE ? "'>'" : "']'");
+        }
+        pos++;
+    }
+
+    return ref;
+}
+
+const Token& DeclarationParser::peek() const {
+    return tokens_[current_ < tokens_.size() ? current_ : tokens_.size() - 1];
+}
+
+const Token& DeclarationParser::peekNext() const {
+    size_t next = current_ + 1;
+    return tokens_[next < tokens_.size() ? next : tokens_.size() - 1];
+}
+
+const Token& DeclarationParser::advance() {
+    const Token& token = peek();
+    if (token.type != TokenType::END_OF_FILE) {
+        current_++;
+    }
+    return token;
+}
+
+bool DeclarationParser::check(TokenType type) const {
+    return peek().type == type;
+}
+
+bool DeclarationParser::match(TokenType type) {
+    if (!check(type)) return false;
+    advance();
+    return true;
+}
+
+const Token& DeclarationParser::expect(TokenType type, const char* what) {
+    if (!check(type)) {
+        unexpected(peek(), what);
+    }
+    return advance();
+}
+
+ClassDecl DeclarationParser::classDeclaration() {
+    const Token& keyword = expect(TokenType::CLASS, "class declaration");
+
+    ClassDecl decl;
+    decl.name = expect(TokenType::IDENTIFIER, "class name").lexeme;
+    decl.line = keyword.line;
+    decl.column = keyword.column;
+
+    if (check(TokenType::LANGLE) || check(TokenType::LBRACKET)) {
+        TokenType close = advance().type == TokenType::LANGLE ? TokenType::RANGLE : TokenType::RBRACKET;
+        do {
+            decl.genericParameters.push_back(expect(TokenType::IDENTIFIER, "type parameter").lexeme);
+        } while (match(TokenType::COMMA));
+        expect(close, close == TokenType::RANGLE ? "'>'" : "']'");
+    }
+
+    if (match(TokenType::EXTENDS)) {
+        decl.base = type();
+    }
+
+    expect(TokenType::IS, "'is'");
+    while (!check(TokenType::END)) {
+        member(decl);
+    }
+    advance();
+
+    return decl;
+}
+
+void DeclarationParser::member(ClassDecl& decl) {
+    switch (peek().type) {
+        case TokenType::VAR:
+            decl.fields.push_back(field());
+            break;
+        case TokenType::METHOD:
+            decl.methods.push_back(method());
+            break;
+        case TokenType::THIS:
+            decl.constructors.push_back(constructor());
+            break;
+        default:
+            unexpected(peek(), "member declaration");
+    }
+}
+
+FieldDecl DeclarationParser::field() {
+    advance();
+    const Token& name = expect(TokenType::IDENTIFIER, "field name");
+
+    FieldDecl decl;
+    decl.name = name.lexeme;
+    decl.line = name.line;
+    decl.column = name.column;
+
+    // var x : Type, var x : Type(args), var x : literal, var x = Type(...), var x = literal
+    if (match(TokenType::COLON)) {
+        if (check(TokenType::IDENTIFIER) && peekNext().type != TokenType::DOT) {
+            decl.type = type();
+        }
+    } else if (match(TokenType::EQUAL) || match(TokenType::ASSIGN)) {
+        TokenType next = peekNext().type;
+        if (check(TokenType::IDENTIFIER) &&
+            (next == TokenType::LPAREN || next == TokenType::LANGLE || next == TokenType::LBRACKET)) {
+            decl.type = type();
+        }
+    }
+
+    if (!decl.type) {
+        if (const char* literal = literalType(peek().type)) {
+            decl.type = TypeRef{literal, {}, peek().line, peek().column};
+        }
+    }
+
+    expression(true);
+    return decl;
+}
+
+MethodDecl DeclarationParser::method() {
+    advance();
+    const Token& name = expect(TokenType::IDENTIFIER, "method name");
+
+    MethodDecl decl;
+    decl.name = name.lexeme;
+    decl.line = name.line;
+    decl.column = name.column;
+
+    if (check(TokenType::LPAREN)) {
+        decl.parameters = parameters();
+    }
+    if (match(TokenType::COLON)) {
+        decl.returnType = type();
+    }
+
+    // Without 'is' or '=>' this is a forward declaration
+    if (match(TokenType::IS)) {
+        decl.body = body();
+    } else if (match(TokenType::ARROW)) {
+        decl.body = expression(false);
+    }
+
+    return decl;
+}
+
+ConstructorDecl DeclarationParser::constructor() {
+    const Token& keyword = advance();
+
+    ConstructorDecl decl;
+    decl.line = keyword.line;
+    decl.column = keyword.column;
+
+    if (check(TokenType::LPAREN)) {
+        decl.parameters = parameters();
+    }
+    expect(TokenType::IS, "'is'");
+    decl.body = body();
+
+    return decl;
+}
+
+std::vector<Parameter> DeclarationParser::parameters() {
+    std::vector<Parameter> result;
+    expect(TokenType::LPAREN, "'('");
+
+    if (!check(TokenType::RPAREN)) {
+        do {
+            Parameter parameter;
+            parameter.name = expect(TokenType::IDENTIFIER, "parameter name").lexeme;
+            expect(TokenType::COLON, "':'");
+            parameter.type = type();
+            result.push_back(std::move(parameter));
+        } while (match(TokenType::COMMA));
+    }
+
+    expect(TokenType::RPAREN, "')'");
+    return result;
+}
+
+TypeRef DeclarationParser::type() {
+    return parseType(tokens_, current_);
+}
+
+BodyRange DeclarationParser::body() {
+    // 'then' and 'loop' open nested blocks; every block, the body included, closes with 'end'
+    BodyRange range;
+    range.begin = current_;
+    int depth = 1;
+
+    for (;;) {
+        const Token& token = peek();
+        if (token.type == TokenType::END_OF_FILE) {
+            unexpected(token, "'end'");
+        }
+        advance();
+        if (token.type == TokenType::THEN || token.type == TokenType::LOOP) {
+            depth++;
+        } else if (token.type == TokenType::END && --depth == 0) {
+            break;
+        }
+    }
+
+    range.end = current_ - 1;
+    return range;
+}
+
+BodyRange DeclarationParser::expression(bool allowEmpty) {
+    // Runs to the next member declaration or the end of the class.
+    // 'this(' starts a constructor unless it opens a required expression.
+    BodyRange range;
+    range.begin = current_;
+    int depth = 0;
+
+    for (;;) {
+        TokenType type = peek().type;
+        if (type == TokenType::END_OF_FILE) {
+            break;
+        }
+        if (depth == 0) {
+            bool constructorStart = type == TokenType::THIS && peekNext().type == TokenType::LPAREN &&
+                                    (allowEmpty || current_ > range.begin);
+            if (type == TokenType::VAR || type == TokenType::METHOD || type == TokenType::END || constructorStart) {
+                break;
+            }
+        }
+        if (type == TokenType::LPAREN || type == TokenType::LBRACKET || type == TokenType::LBRACE) {
+            depth++;
+        } else if ((type == TokenType::RPAREN || type == TokenType::RBRACKET || type == TokenType::RBRACE) &&
+                   depth > 0) {
+            depth--;
+        }
+        advance();
+    }
+
+    range.end = current_;
+    if (!allowEmpty && range.begin == range.end) {
+        unexpected(peek(), "expression");
+    }
+    return range;
+}
+
+}
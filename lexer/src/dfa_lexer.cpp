@@ -0,0 +1,442 @@
+#include "dfa_lexer.h"
+#include "lexer.h"
+#include "literal.h"
+#include "token_spec.h"
+#include <array>
+#include <sstream>
+
+namespace olang {
+
+namespace {
+
+using spec::Action;
+using spec::CharSet;
+using spec::Pattern;
+
+constexpr size_t MAX_CLASSES = 64;
+constexpr size_t MAX_TRIE_NODES = 160;
+constexpr size_t MAX_STATES = 192;
+constexpr int NO_NODE = -1;
+
+constexpr uint8_t DEAD = 0;
+constexpr uint8_t START = 1;
+
+struct Accept {
+    Action action = Action::NONE;
+    TokenType type = TokenType::INVALID;
+};
+
+constexpr bool sameAccept(const Accept& a, const Accept& b) {
+    return a.action == b.action && a.type == b.type;
+}
+
+// Bytes that no rule can tell apart share one class, which keeps the table narrow
+struct ByteClasses {
+    std::array<uint8_t, 256> classOf{};
+    std::array<uint8_t, MAX_CLASSES> representative{};
+    size_t count = 0;
+};
+
+constexpr bool inFixedSpelling(unsigned char c) {
+    for (const auto& rule : spec::FIXED_RULES) {
+        for (const char* p = rule.spelling; *p != '\0'; ++p) {
+            if (static_cast<unsigned char>(*p) == c) return true;
+        }
+    }
+    return false;
+}
+
+constexpr int byteSignature(unsigned char c) {
+    // Bytes of fixed spellings are told apart individually, the rest only by char set
+    return inFixedSpelling(c) ? 256 + c : static_cast<int>(spec::charSetOf(c));
+}
+
+constexpr ByteClasses buildByteClasses() {
+    ByteClasses classes;
+    std::array<int, MAX_CLASSES> signatures{};
+
+    for (int c = 0; c < 256; ++c) {
+        int signature = byteSignature(static_cast<unsigned char>(c));
+        size_t found = classes.count;
+        for (size_t k = 0; k < classes.count; ++k) {
+            if (signatures[k] == signature) {
+                found = k;
+                break;
+            }
+        }
+        if (found == classes.count) {
+            signatures[found] = signature;
+            classes.representative[found] = static_cast<uint8_t>(c);
+            classes.count++;
+        }
+        classes.classOf[c] = static_cast<uint8_t>(found);
+    }
+
+    return classes;
+}
+
+// Trie over the fixed spellings, indexed by byte class
+struct Trie {
+    std::array<std::array<int16_t, MAX_CLASSES>, MAX_TRIE_NODES> next{};
+    std::array<Accept, MAX_TRIE_NODES> accept{};
+    size_t count = 0;
+};
+
+constexpr Trie buildTrie(const ByteClasses& classes) {
+    Trie trie;
+    for (auto& row : trie.next) {
+        for (auto& target : row) {
+            target = NO_NODE;
+        }
+    }
+    trie.count = 1;
+
+    for (const auto& rule : spec::FIXED_RULES) {
+        size_t node = 0;
+        for (const char* p = rule.spelling; *p != '\0'; ++p) {
+            uint8_t cls = classes.classOf[static_cast<unsigned char>(*p)];
+            if (trie.next[node][cls] == NO_NODE) {
+                trie.next[node][cls] = static_cast<int16_t>(trie.count++);
+            }
+            node = static_cast<size_t>(trie.next[node][cls]);
+        }
+        trie.accept[node] = Accept{rule.action, rule.type};
+    }
+
+    return trie;
+}
+
+constexpr Pattern patternStep(Pattern from, CharSet on) {
+    for (const auto& edge : spec::PATTERN_EDGES) {
+        if (edge.from == from && edge.on == on) return edge.to;
+    }
+    return Pattern::NONE;
+}
+
+constexpr Accept patternAccept(Pattern state) {
+    for (const auto& accept : spec::PATTERN_ACCEPTS) {
+        if (accept.state == state) return Accept{accept.action, accept.type};
+    }
+    return Accept{};
+}
+
+struct Dfa {
+    std::array<std::array<uint8_t, MAX_CLASSES>, MAX_STATES> next{};
+    std::array<Accept, MAX_STATES> accept{};
+    size_t count = 0;
+};
+
+// Subset construction of the trie running in parallel with the pattern automaton.
+// A DFA state is a (trie node, pattern state) pair; state 0 is the dead pair.
+constexpr Dfa buildProduct(const ByteClasses& classes, const Trie& trie) {
+    Dfa dfa;
+    std::array<int, MAX_STATES> nodeOf{};
+    std::array<Pattern, MAX_STATES> patternOf{};
+
+    nodeOf[DEAD] = NO_NODE;
+    patternOf[DEAD] = Pattern::NONE;
+    nodeOf[START] = 0;
+    patternOf[START] = Pattern::START;
+    dfa.count = 2;
+
+    for (size_t s = 0; s < dfa.count; ++s) {
+        int node = nodeOf[s];
+        Pattern pattern = patternOf[s];
+
+        Accept accept = node != NO_NODE ? trie.accept[node] : Accept{};
+        if (accept.action == Action::NONE && pattern != Pattern::NONE) {
+            accept = patternAccept(pattern);
+        }
+        dfa.accept[s] = accept;
+
+        for (size_t c = 0; c < classes.count; ++c) {
+            int nextNode = node != NO_NODE ? trie.next[node][c] : NO_NODE;
+            Pattern nextPattern = pattern != Pattern::NONE
+                ? patternStep(pattern, spec::charSetOf(classes.representative[c]))
+                : Pattern::NONE;
+
+            size_t target = DEAD;
+            if (nextNode != NO_NODE || nextPattern != Pattern::NONE) {
+                target = dfa.count;
+                for (size_t t = 0; t < dfa.count; ++t) {
+                    if (nodeOf[t] == nextNode && patternOf[t] == nextPattern) {
+                        target = t;
+                        break;
+                    }
+                }
+                if (target == dfa.count) {
+                    nodeOf[target] = nextNode;
+                    patternOf[target] = nextPattern;
+                    dfa.count++;
+                }
+            }
+            dfa.next[s][c] = static_cast<uint8_t>(target);
+        }
+    }
+
+    return dfa;
+}
+
+// Moore partition refinement. Blocks are numbered in order of their first
+// state, so the dead state stays 0 and the start state stays 1.
+constexpr Dfa minimize(const Dfa& dfa, size_t classCount) {
+    std::array<uint8_t, MAX_STATES> block{};
+    std::array<size_t, MAX_STATES> representative{};
+    size_t blocks = 0;
+
+    for (size_t s = 0; s < dfa.count; ++s) {
+        size_t found = blocks;
+        for (size_t k = 0; k < blocks; ++k) {
+            if (sameAccept(dfa.accept[representative[k]], dfa.accept[s])) {
+                found = k;
+                break;
+            }
+        }
+        if (found == blocks) {
+            representative[blocks++] = s;
+        }
+        block[s] = static_cast<uint8_t>(found);
+    }
+
+    for (;;) {
+        std::array<uint8_t, MAX_STATES> refined{};
+        size_t refinedCount = 0;
+
+        for (size_t s = 0; s < dfa.count; ++s) {
+            size_t found = refinedCount;
+            for (size_t k = 0; k < refinedCount && found == refinedCount; ++k) {
+                size_t r = representative[k];
+                if (block[r] != block[s]) continue;
+                bool same = true;
+                for (size_t c = 0; c < classCount && same; ++c) {
+                    same = block[dfa.next[r][c]] == block[dfa.next[s][c]];
+                }
+                if (same) found = k;
+            }
+            if (found == refinedCount) {
+                representative[refinedCount++] = s;
+            }
+            refined[s] = static_cast<uint8_t>(found);
+        }
+
+        bool stable = refinedCount == blocks;
+        block = refined;
+        blocks = refinedCount;
+        if (stable) break;
+    }
+
+    Dfa result;
+    result.count = blocks;
+    for (size_t s = 0; s < dfa.count; ++s) {
+        result.accept[block[s]] = dfa.accept[s];
+        for (size_t c = 0; c < classCount; ++c) {
+            result.next[block[s]][c] = block[dfa.next[s][c]];
+        }
+    }
+    return result;
+}
+
+struct Tables {
+    ByteClasses classes;
+    Dfa dfa;
+};
+
+constexpr Tables buildTables() {
+    Tables tables;
+    tables.classes = buildByteClasses();
+    Trie trie = buildTrie(tables.classes);
+    tables.dfa = minimize(buildProduct(tables.classes, trie), tables.classes.count);
+    return tables;
+}
+
+constexpr Tables TABLES = buildTables();
+
+static_assert(TABLES.classes.count <= MAX_CLASSES, "too many byte classes in token spec");
+static_assert(TABLES.dfa.count <= MAX_STATES, "too many DFA states in token spec");
+// The scanner relies on the terminating NUL leading to the dead state
+static_assert(TABLES.dfa.next[START][TABLES.classes.classOf[0]] == DEAD, "NUL must not start a token");
+
+}
+
+DfaLexer::DfaLexer(std::string source)
+    : DfaLexer(std::move(source), std::make_shared<ConstantPool>()) {}
+
+DfaLexer::DfaLexer(std::string source, std::shared_ptr<ConstantPool> constants)
+    : source_(std::move(source)), current_(0), line_(1), column_(1),
+      constants_(constants ? std::move(constants) : std::make_shared<ConstantPool>()) {}
+
+size_t DfaLexer::stateCount() {
+    return TABLES.dfa.count;
+}
+
+size_t DfaLexer::byteClassCount() {
+    return TABLES.classes.count;
+}
+
+std::vector<Token> DfaLexer::tokenize() {
+    std::vector<Token> tokens;
+
+    for (;;) {
+        Token token = nextToken();
+        bool done = token.type == TokenType::END_OF_FILE;
+        tokens.push_back(std::move(token));
+        if (done) {
+            break;
+        }
+    }
+
+    return tokens;
+}
+
+Token DfaLexer::nextToken() {
+    const auto& classOf = TABLES.classes.classOf;
+    const auto& next = TABLES.dfa.next;
+    const auto& accept = TABLES.dfa.accept;
+    // c_str() is NUL-terminated, and NUL moves every state to DEAD
+    const auto* input = reinterpret_cast<const unsigned char*>(source_.c_str());
+
+    for (;;) {
+        if (current_ >= source_.size()) {
+            return Token(TokenType::END_OF_FILE, "", line_, column_);
+        }
+
+        // Longest match: remember the last accepting state without branching on it
+        size_t state = START;
+        size_t pos = current_;
+        size_t matchState = DEAD;
+        size_t matchEnd = current_;
+        for (;;) {
+            size_t target = next[state][classOf[input[pos]]];
+            if (target == DEAD) break;
+            state = target;
+            ++pos;
+            bool accepting = accept[state].action != Action::NONE;
+            matchState = accepting ? state : matchState;
+            matchEnd = accepting ? pos : matchEnd;
+        }
+
+        const Accept& match = accept[matchState];
+        switch (match.action) {
+            case Action::EMIT:
+                return emit(match.type, current_, matchEnd);
+            case Action::STRING:
+                return string(current_);
+            case Action::SKIP_WHITESPACE:
+                advanceTo(matchEnd);
+                break;
+            case Action::LINE_COMMENT:
+                advanceTo(matchEnd);
+                skipLineComment();
+                break;
+            case Action::BLOCK_COMMENT:
+                advanceTo(matchEnd);
+                skipBlockComment();
+                break;
+            case Action::NONE: {
+                std::ostringstream oss;
+                oss << "Unexpected character '" << source_[current_] << "'";
+                throw LexerError(oss.str(), line_, column_);
+            }
+        }
+    }
+}
+
+void DfaLexer::advanceTo(size_t end) {
+    for (; current_ < end; ++current_) {
+        if (source_[current_] == '\n') {
+            line_++;
+            column_ = 1;
+        } else {
+            column_++;
+        }
+    }
+}
+
+Token DfaLexer::emit(TokenType type, size_t start, size_t end) {
+    // Emitted tokens never span lines
+    size_t column = column_;
+    column_ += end - start;
+    current_ = end;
+
+    std::string_view text = std::string_view(source_).substr(start, end - start);
+    switch (type) {
+        case TokenType::TRUE:
+        case TokenType::FALSE: {
+            bool value = type == TokenType::TRUE;
+            Token token(type, std::string(text), value, line_, column);
+            token.constant = constants_->intern(value);
+            return token;
+        }
+        case TokenType::INTEGER_LITERAL: {
+            int64_t value = decodeInteger(text, line_, column);
+            Token token(type, std::string(text), value, line_, column);
+            token.constant = constants_->intern(value);
+            return token;
+        }
+        case TokenType::REAL_LITERAL: {
+            double value = decodeReal(text, line_, column);
+            Token token(type, std::string(text), value, line_, column);
+            token.constant = constants_->intern(value);
+            return token;
+        }
+        default:
+            return Token(type, std::string(text), line_, column);
+    }
+}
+
+Token DfaLexer::string(size_t start) {
+    size_t startColumn = column_;
+
+    size_t end = source_.find_first_of("\"\\", start + 1);
+    while (end != std::string::npos && source_[end] == '\\') {
+        end = source_.find_first_of("\"\\", end + 2);
+    }
+
+    if (end == std::string::npos) {
+        advanceTo(source_.size());
+        throw LexerError("Unterminated string literal", line_, column_);
+    }
+
+    std::string value = decodeString(std::string_view(source_).substr(start + 1, end - start - 1));
+    advanceTo(end + 1);
+
+    uint32_t constant = constants_->intern(value);
+    Token token(TokenType::STRING_LITERAL, source_.substr(start, end + 1 - start), std::move(value), line_,
+                startColumn);
+    token.constant = constant;
+    return token;
+}
+
+void DfaLexer::skipLineComment() {
+    size_t end = source_.find('\n', current_);
+    if (end == std::string::npos) {
+        end = source_.size();
+    }
+    column_ += end - current_;
+    current_ = end;
+}
+
+void DfaLexer::skipBlockComment() {
+    size_t pos = current_;
+    size_t size = source_.size();
+    int depth = 1;
+
+    while (pos < size && depth > 0) {
+        if (source_[pos] == '/' && pos + 1 < size && source_[pos + 1] == '*') {
+            pos += 2;
+            depth++;
+        } else if (source_[pos] == '*' && pos + 1 < size && source_[pos + 1] == '/') {
+            pos += 2;
+            depth--;
+        } else {
+            pos++;
+        }
+    }
+
+    advanceTo(pos);
+    if (depth > 0) {
+        throw LexerError("Unterminated block comment", line_, column_);
+    }
+}
+
+}
@@ -0,0 +1,489 @@
+#include "interface_file.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <unordered_map>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define OLANG_HAS_MMAP 1
+#endif
+
+namespace olang {
+
+namespace {
+
+constexpr char MAGIC[4] = {'O', 'L', 'I', 'F'};
+constexpr size_t HEADER_SIZE = 40;
+constexpr size_t INDEX_ENTRY_SIZE = 16;
+constexpr size_t DEPENDENCY_ENTRY_SIZE = 16;
+constexpr size_t STRINGS_SIZE_OFFSET = 28;
+constexpr int MAX_TYPE_DEPTH = 64;
+
+class Encoder {
+private:
+    std::vector<uint8_t> bytes_;
+    std::string strings_;
+    std::unordered_map<std::string, uint32_t> offsets_;
+
+public:
+    std::vector<uint8_t>& bytes() { return bytes_; }
+    const std::string& strings() const { return strings_; }
+
+    void u8(uint8_t value) {
+        bytes_.push_back(value);
+    }
+
+    void u32(uint32_t value) {
+        for (int shift = 0; shift < 32; shift += 8) {
+            bytes_.push_back(static_cast<uint8_t>(value >> shift));
+        }
+    }
+
+    void u64(uint64_t value) {
+        u32(static_cast<uint32_t>(value));
+        u32(static_cast<uint32_t>(value >> 32));
+    }
+
+    uint32_t intern(const std::string& value) {
+        auto it = offsets_.find(value);
+        if (it != offsets_.end()) {
+            return it->second;
+        }
+        uint32_t offset = static_cast<uint32_t>(strings_.size());
+        strings_ += value;
+        offsets_.emplace(value, offset);
+        return offset;
+    }
+
+    void string(const std::string& value) {
+        u32(intern(value));
+        u32(static_cast<uint32_t>(value.size()));
+    }
+
+    void position(size_t line, size_t column) {
+        u32(static_cast<uint32_t>(line));
+        u32(static_cast<uint32_t>(column));
+    }
+
+    void type(const TypeRef& ref) {
+        string(ref.name);
+        position(ref.line, ref.column);
+        u32(static_cast<uint32_t>(ref.arguments.size()));
+        for (const TypeRef& argument : ref.arguments) {
+            type(argument);
+        }
+    }
+
+    void optionalType(const std::optional<TypeRef>& ref) {
+        u8(ref ? 1 : 0);
+        if (ref) {
+            type(*ref);
+        }
+    }
+
+    void parameters(const std::vector<Parameter>& list) {
+        u32(static_cast<uint32_t>(list.size()));
+        for (const Parameter& parameter : list) {
+            string(parameter.name);
+            type(parameter.type);
+        }
+    }
+
+    void classRecord(const ClassDecl& decl) {
+        string(decl.name);
+        position(decl.line, decl.column);
+
+        u32(static_cast<uint32_t>(decl.genericParameters.size()));
+        for (const std::string& parameter : decl.genericParameters) {
+            string(parameter);
+        }
+        optionalType(decl.base);
+
+        u32(static_cast<uint32_t>(decl.fields.size()));
+        for (const FieldDecl& field : decl.fields) {
+            string(field.name);
+            optionalType(field.type);
+            position(field.line, field.column);
+        }
+
+        u32(static_cast<uint32_t>(decl.methods.size()));
+        for (const MethodDecl& method : decl.methods) {
+            string(method.name);
+            parameters(method.parameters);
+            optionalType(method.returnType);
+            u8(method.body ? 1 : 0);
+            position(method.line, method.column);
+        }
+
+        u32(static_cast<uint32_t>(decl.constructors.size()));
+        for (const ConstructorDecl& constructor : decl.constructors) {
+            parameters(constructor.parameters);
+            position(constructor.line, constructor.column);
+        }
+    }
+};
+
+void putU32(std::vector<uint8_t>& bytes, size_t offset, uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+        bytes[offset + i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+[[noreturn]] void malformed(const char* what) {
+    throw std::runtime_error(std::string("Malformed interface file: ") + what);
+}
+
+// Bounds-checked sequential reader over one class record
+class Decoder {
+private:
+    const uint8_t* data_;
+    size_t size_;
+    size_t pos_;
+    std::string_view strings_;
+
+public:
+    Decoder(const uint8_t* data, size_t size, size_t pos, std::string_view strings)
+        : data_(data), size_(size), pos_(pos), strings_(strings) {}
+
+    uint8_t u8() {
+        if (pos_ + 1 > size_) malformed("truncated record");
+        return data_[pos_++];
+    }
+
+    uint32_t u32() {
+        if (pos_ + 4 > size_) malformed("truncated record");
+        uint32_t value = 0;
+        for (int i = 0; i < 4; ++i) {
+            value |= static_cast<uint32_t>(data_[pos_ + i]) << (8 * i);
+        }
+        pos_ += 4;
+        return value;
+    }
+
+    // Counts come from the file; a count larger than the remaining bytes cannot be valid
+    uint32_t count() {
+        uint32_t value = u32();
+        if (value > size_ - pos_) malformed("bad element count");
+        return value;
+    }
+
+    std::string string() {
+        uint32_t offset = u32();
+        uint32_t length = u32();
+        if (static_cast<size_t>(offset) + length > strings_.size()) malformed("bad string reference");
+        return std::string(strings_.substr(offset, length));
+    }
+
+    TypeRef type(int depth = 0) {
+        if (depth > MAX_TYPE_DEPTH) malformed("type nested too deeply");
+        TypeRef ref;
+        ref.name = string();
+        ref.line = u32();
+        ref.column = u32();
+        uint32_t arguments = count();
+        for (uint32_t i = 0; i < arguments; ++i) {
+            ref.arguments.push_back(type(depth + 1));
+        }
+        return ref;
+    }
+
+    std::optional<TypeRef> optionalType() {
+        if (u8() == 0) return std::nullopt;
+        return type();
+    }
+
+    std::vector<Parameter> parameters() {
+        std::vector<Parameter> list(count());
+        for (Parameter& parameter : list) {
+            parameter.name = string();
+            parameter.type = type();
+        }
+        return list;
+    }
+
+    ClassDecl classRecord() {
+        ClassDecl decl;
+        decl.name = string();
+        decl.line = u32();
+        decl.column = u32();
+
+        decl.genericParameters.resize(count());
+        for (std::string& parameter : decl.genericParameters) {
+            parameter = string();
+        }
+        decl.base = optionalType();
+
+        decl.fields.resize(count());
+        for (FieldDecl& field : decl.fields) {
+            field.name = string();
+            field.type = optionalType();
+            field.line = u32();
+            field.column = u32();
+        }
+
+        decl.methods.resize(count());
+        for (MethodDecl& method : decl.methods) {
+            method.name = string();
+            method.parameters = parameters();
+            method.returnType = optionalType();
+            if (u8() != 0) {
+                method.body = BodyRange{};
+            }
+            method.line = u32();
+            method.column = u32();
+        }
+
+        decl.constructors.resize(count());
+        for (ConstructorDecl& constructor : decl.constructors) {
+            constructor.parameters = parameters();
+            constructor.line = u32();
+            constructor.column = u32();
+        }
+
+        return decl;
+    }
+};
+
+}
+
+std::vector<uint8_t> InterfaceFile::encode(uint64_t sourceHash, const std::vector<ClassDecl>& classes,
+                                           const std::vector<InterfaceDependency>& dependencies) {
+    Encoder records;
+    std::vector<uint32_t> recordOffsets;
+    for (const ClassDecl& decl : classes) {
+        recordOffsets.push_back(static_cast<uint32_t>(records.bytes().size()));
+        records.classRecord(decl);
+    }
+
+    std::vector<size_t> order(classes.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&classes](size_t a, size_t b) {
+        return classes[a].name < classes[b].name;
+    });
+
+    size_t indexOffset = HEADER_SIZE;
+    size_t dependenciesOffset = indexOffset + classes.size() * INDEX_ENTRY_SIZE;
+    size_t recordsOffset = dependenciesOffset + dependencies.size() * DEPENDENCY_ENTRY_SIZE;
+    size_t stringsOffset = recordsOffset + records.bytes().size();
+
+    Encoder file;
+    for (char c : MAGIC) {
+        file.u8(static_cast<uint8_t>(c));
+    }
+    file.u32(VERSION);
+    file.u64(sourceHash);
+    file.u32(static_cast<uint32_t>(classes.size()));
+    file.u32(static_cast<uint32_t>(indexOffset));
+    file.u32(static_cast<uint32_t>(stringsOffset));
+    file.u32(0);  // string table size, patched below
+    file.u32(static_cast<uint32_t>(dependenciesOffset));
+    file.u32(static_cast<uint32_t>(dependencies.size()));
+
+    // Names go through the record encoder's string table so both share it
+    for (size_t i : order) {
+        file.u32(records.intern(classes[i].name));
+        file.u32(static_cast<uint32_t>(classes[i].name.size()));
+        file.u32(static_cast<uint32_t>(recordsOffset + recordOffsets[i]));
+        file.u32(static_cast<uint32_t>(classes[i].genericParameters.size()));
+    }
+    for (const InterfaceDependency& dependency : dependencies) {
+        file.u32(records.intern(dependency.className));
+        file.u32(static_cast<uint32_t>(dependency.className.size()));
+        file.u32(records.intern(dependency.interface));
+        file.u32(static_cast<uint32_t>(dependency.interface.size()));
+    }
+
+    std::vector<uint8_t>& bytes = file.bytes();
+    bytes.insert(bytes.end(), records.bytes().begin(), records.bytes().end());
+    bytes.insert(bytes.end(), records.strings().begin(), records.strings().end());
+    putU32(bytes, STRINGS_SIZE_OFFSET, static_cast<uint32_t>(records.strings().size()));
+    return bytes;
+}
+
+void InterfaceFile::write(const std::string& path, uint64_t sourceHash, const std::vector<ClassDecl>& classes,
+                          const std::vector<InterfaceDependency>& dependencies) {
+    std::vector<uint8_t> bytes = encode(sourceHash, classes, dependencies);
+
+    // Write and rename, so a reader never maps a half-written file
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            throw std::runtime_error("Could not write file: " + temporary);
+        }
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        if (!file) {
+            throw std::runtime_error("Could not write file: " + temporary);
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temporary, path, ec);
+    if (ec) {
+        std::filesystem::remove(temporary, ec);
+        throw std::runtime_error("Could not write file: " + path);
+    }
+}
+
+InterfaceFile::InterfaceFile(const std::string& path)
+    : path_(path), data_(nullptr), size_(0), mapping_(nullptr) {
+#ifdef OLANG_HAS_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Could not open file: " + path);
+    }
+    struct stat info;
+    if (::fstat(fd, &info) < 0 || info.st_size < static_cast<off_t>(HEADER_SIZE)) {
+        ::close(fd);
+        malformed("file too small");
+    }
+    size_ = static_cast<size_t>(info.st_size);
+    void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Could not map file: " + path);
+    }
+    mapping_ = mapping;
+    data_ = static_cast<const uint8_t*>(mapping);
+#else
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open file: " + path);
+    }
+    buffer_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+#endif
+
+    try {
+        validate();
+    } catch (...) {
+#ifdef OLANG_HAS_MMAP
+        ::munmap(mapping_, size_);
+#endif
+        throw;
+    }
+}
+
+InterfaceFile::~InterfaceFile() {
+#ifdef OLANG_HAS_MMAP
+    if (mapping_) {
+        ::munmap(mapping_, size_);
+    }
+#endif
+}
+
+void InterfaceFile::validate() const {
+    if (size_ < HEADER_SIZE) malformed("file too small");
+    if (std::memcmp(data_, MAGIC, sizeof(MAGIC)) != 0) malformed("bad magic");
+    if (u32(4) != VERSION) malformed("unsupported version");
+
+    size_t count = u32(16);
+    size_t indexOffset = u32(20);
+    size_t stringsOffset = u32(24);
+    size_t stringsSize = u32(28);
+    if (indexOffset + count * INDEX_ENTRY_SIZE > size_) malformed("index out of bounds");
+    if (stringsOffset + stringsSize > size_) malformed("string table out of bounds");
+    size_t dependenciesOffset = u32(32);
+    size_t dependencyCount = u32(36);
+    if (dependenciesOffset + dependencyCount * DEPENDENCY_ENTRY_SIZE > size_) malformed("dependencies out of bounds");
+}
+
+uint32_t InterfaceFile::u32(size_t offset) const {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) {
+        value |= static_cast<uint32_t>(data_[offset + i]) << (8 * i);
+    }
+    return value;
+}
+
+std::string_view InterfaceFile::string(uint32_t offset, uint32_t length) const {
+    std::string_view strings(reinterpret_cast<const char*>(data_) + u32(24), u32(28));
+    if (static_cast<size_t>(offset) + length > strings.size()) malformed("bad string reference");
+    return strings.substr(offset, length);
+}
+
+uint64_t InterfaceFile::sourceHash() const {
+    return static_cast<uint64_t>(u32(8)) | (static_cast<uint64_t>(u32(12)) << 32);
+}
+
+size_t InterfaceFile::classCount() const {
+    return u32(16);
+}
+
+std::string_view InterfaceFile::className(size_t index) const {
+    size_t entry = u32(20) + index * INDEX_ENTRY_SIZE;
+    return string(u32(entry), u32(entry + 4));
+}
+
+size_t InterfaceFile::genericCount(size_t index) const {
+    return u32(u32(20) + index * INDEX_ENTRY_SIZE + 12);
+}
+
+std::optional<size_t> InterfaceFile::find(std::string_view name) const {
+    size_t low = 0;
+    size_t high = classCount();
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        std::string_view candidate = className(middle);
+        if (candidate == name) {
+            return middle;
+        }
+        if (candidate < name) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return std::nullopt;
+}
+
+std::vector<InterfaceDependency> InterfaceFile::dependencies() const {
+    std::vector<InterfaceDependency> result;
+    for (size_t i = 0; i < u32(36); ++i) {
+        size_t entry = u32(32) + i * DEPENDENCY_ENTRY_SIZE;
+        result.push_back(InterfaceDependency{std::string(string(u32(entry), u32(entry + 4))),
+                                             std::string(string(u32(entry + 8), u32(entry + 12)))});
+    }
+    return result;
+}
+
+std::optional<std::string> InterfaceFile::dependency(std::string_view className) const {
+    for (size_t i = 0; i < u32(36); ++i) {
+        size_t entry = u32(32) + i * DEPENDENCY_ENTRY_SIZE;
+        if (string(u32(entry), u32(entry + 4)) == className) {
+            return std::string(string(u32(entry + 8), u32(entry + 12)));
+        }
+    }
+    return std::nullopt;
+}
+
+ClassDecl InterfaceFile::decode(size_t index) const {
+    size_t record = u32(u32(20) + index * INDEX_ENTRY_SIZE + 8);
+    std::string_view strings(reinterpret_cast<const char*>(data_) + u32(24), u32(28));
+    return Decoder(data_, size_, record, strings).classRecord();
+}
+
+bool updateInterface(const std::string& interfacePath, uint64_t sourceHash, const std::vector<ClassDecl>& classes,
+                     const std::vector<InterfaceDependency>& dependencies) {
+    try {
+        InterfaceFile existing(interfacePath);
+        if (existing.sourceHash() == sourceHash && existing.dependencies() == dependencies) {
+            return false;
+        }
+    } catch (const std::runtime_error&) {
+        // Missing or unreadable: rebuild
+    }
+    InterfaceFile::write(interfacePath, sourceHash, classes, dependencies);
+    return true;
+}
+
+}
@@ -1,4 +1,5 @@
 #include "lexer.h"
+#include "literal.h"
 #include <cctype>
 #include <sstream>
 
@@ -24,7 +25,11 @@ const std::unordered_map<std::string, TokenType> Lexer::keywords_ = {
 };
 
 Lexer::Lexer(std::string source)
-    : source_(std::move(source)), current_(0), line_(1), column_(1) {}
+    : Lexer(std::move(source), std::make_shared<ConstantPool>()) {}
+
+Lexer::Lexer(std::string source, std::shared_ptr<ConstantPool> constants)
+    : source_(std::move(source)), current_(0), line_(1), column_(1),
+      constants_(constants ? std::move(constants) : std::make_shared<ConstantPool>()) {}
 
 std::vector<Token> Lexer::tokenize() {
     std::vector<Token> tokens;
@@ -210,10 +215,11 @@ Token Lexer::identifier() {
     auto it = keywords_.find(text);
     if (it != keywords_.end()) {
         TokenType type = it->second;
-        if (type == TokenType::TRUE) {
-            return Token(type, text, true, line_, startColumn);
-        } else if (type == TokenType::FALSE) {
-            return Token(type, text, false, line_, startColumn);
+        if (type == TokenType::TRUE || type == TokenType::FALSE) {
+            bool value = type == TokenType::TRUE;
+            Token token(type, std::move(text), value, line_, startColumn);
+            token.constant = constants_->intern(value);
+            return token;
         }
         return Token(type, text, line_, startColumn);
     }
@@ -239,21 +245,24 @@ Token Lexer::number() {
         }
     }
     
-    std::string text = source_.substr(start, current_ - start);
+    std::string_view text = std::string_view(source_).substr(start, current_ - start);
     
     if (isReal) {
-        double value = std::stod(text);
-        return Token(TokenType::REAL_LITERAL, text, value, line_, startColumn);
+        double value = decodeReal(text, line_, startColumn);
+        Token token(TokenType::REAL_LITERAL, std::string(text), value, line_, startColumn);
+        token.constant = constants_->intern(value);
+        return token;
     } else {
-        int64_t value = std::stoll(text);
-        return Token(TokenType::INTEGER_LITERAL, text, value, line_, startColumn);
+        int64_t value = decodeInteger(text, line_, startColumn);
+        Token token(TokenType::INTEGER_LITERAL, std::string(text), value, line_, startColumn);
+        token.constant = constants_->intern(value);
+        return token;
     }
 }
 
 Token Lexer::string() {
     size_t start = current_;
     size_t startColumn = column_ - 1;
-    std::string value;
     
     while (!isAtEnd() && peek() != '"') {
         if (peek() == '\\') {
@@ -261,31 +270,22 @@ Token Lexer::string() {
             if (isAtEnd()) {
                 throw LexerError("Unterminated string literal", line_, column_);
             }
-            char escaped = advance();
-            switch (escaped) {
-                case 'n': value += '\n'; break;
-                case 't': value += '\t'; break;
-                case 'r': value += '\r'; break;
-                case '\\': value += '\\'; break;
-                case '"': value += '"'; break;
-                default:
-                    value += '\\';
-                    value += escaped;
-                    break;
-            }
-        } else {
-            value += advance();
         }
+        advance();
     }
     
     if (isAtEnd()) {
         throw LexerError("Unterminated string literal", line_, column_);
     }
     
+    std::string value = decodeString(std::string_view(source_).substr(start, current_ - start));
     advance();
     
     std::string lexeme = source_.substr(start - 1, current_ - start + 1);
-    return Token(TokenType::STRING_LITERAL, lexeme, value, line_, startColumn);
+    uint32_t constant = constants_->intern(value);
+    Token token(TokenType::STRING_LITERAL, std::move(lexeme), std::move(value), line_, startColumn);
+    token.constant = constant;
+    return token;
 }
 
 bool Lexer::isAlpha(char c) const {
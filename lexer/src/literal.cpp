@@ -0,0 +1,65 @@
+#include "literal.h"
+#include "lexer.h"
+#include <charconv>
+
+namespace olang {
+
+// from_chars is locale-independent, does not allocate and rounds reals correctly
+
+int64_t decodeInteger(std::string_view text, size_t line, size_t column) {
+    int64_t value = 0;
+    auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (ec == std::errc::result_out_of_range) {
+        throw LexerError("Integer literal out of range", line, column);
+    }
+    if (ec != std::errc() || ptr != text.data() + text.size()) {
+        throw LexerError("Invalid integer literal", line, column);
+    }
+    return value;
+}
+
+double decodeReal(std::string_view text, size_t line, size_t column) {
+    double value = 0.0;
+    auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (ec == std::errc::result_out_of_range) {
+        throw LexerError("Real literal out of range", line, column);
+    }
+    if (ec != std::errc() || ptr != text.data() + text.size()) {
+        throw LexerError("Invalid real literal", line, column);
+    }
+    return value;
+}
+
+std::string decodeString(std::string_view body) {
+    std::string value;
+    size_t escape = body.find('\\');
+    if (escape == std::string_view::npos) {
+        value.assign(body);
+        return value;
+    }
+    
+    // Plain characters are copied in blocks; only escapes are decoded one by one
+    value.reserve(body.size());
+    size_t run = 0;
+    while (escape != std::string_view::npos && escape + 1 < body.size()) {
+        value.append(body, run, escape - run);
+        char escaped = body[escape + 1];
+        switch (escaped) {
+            case 'n': value += '\n'; break;
+            case 't': value += '\t'; break;
+            case 'r': value += '\r'; break;
+            case '\\': value += '\\'; break;
+            case '"': value += '"'; break;
+            default:
+                value += '\\';
+                value += escaped;
+                break;
+        }
+        run = escape + 2;
+        escape = body.find('\\', run);
+    }
+    value.append(body, run, std::string_view::npos);
+    return value;
+}
+
+}
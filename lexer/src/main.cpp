@@ -1,4 +1,5 @@
 #include "lexer.h"
+#include "token_dump.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -24,21 +25,11 @@ int main(int argc, char* argv[]) {
         std::string source = readFile(argv[1]);
         olang::Lexer lexer(source);
         
-        std::cout << "Tokenizing file: " << argv[1] << std::endl;
-        std::cout << std::string(50, '=') << std::endl;
-        
         std::vector<olang::Token> tokens = lexer.tokenize();
-        
-        for (const auto& token : tokens) {
-            std::cout << token << std::endl;
-        }
-        
-        std::cout << std::string(50, '=') << std::endl;
-        std::cout << "Total tokens: " << tokens.size() << std::endl;
+        olang::dumpTokens(std::cout, argv[1], tokens);
         
     } catch (const olang::LexerError& e) {
-        std::cerr << "Lexer error at " << e.line() << ":" << e.column() 
-                  << " - " << e.what() << std::endl;
+        olang::dumpLexerError(std::cerr, e.what(), e.line(), e.column());
         return 1;
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
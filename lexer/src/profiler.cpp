@@ -0,0 +1,176 @@
+#include "profiler.h"
+#include <algorithm>
+#include <iomanip>
+#include <stdexcept>
+#include <utility>
+
+namespace olang {
+
+namespace {
+
+// Depth-first walk without recursion: O call stacks can be far deeper than the C++ one.
+// pre(node) runs before the children of a node, post(node) after them.
+template <typename Nodes, typename Pre, typename Post>
+void walk(const Nodes& nodes, Pre pre, Post post) {
+    std::vector<std::pair<uint32_t, size_t>> stack{{0, 0}};
+    pre(0);
+    while (!stack.empty()) {
+        auto& [node, next] = stack.back();
+        if (next < nodes[node].children.size()) {
+            uint32_t child = nodes[node].children[next++];
+            pre(child);
+            stack.emplace_back(child, 0);
+        } else {
+            post(node);
+            stack.pop_back();
+        }
+    }
+}
+
+double percent(uint64_t part, uint64_t whole) {
+    return whole == 0 ? 0.0 : 100.0 * static_cast<double>(part) / static_cast<double>(whole);
+}
+
+}
+
+Profiler::Profiler(uint64_t interval)
+    : current_(ROOT), interval_(interval), countdown_(interval), samples_(0) {
+    if (interval == 0) {
+        throw std::invalid_argument("Profiler interval must be positive");
+    }
+    nodes_.emplace_back(UINT32_MAX, ROOT);
+}
+
+uint32_t Profiler::addMethod(std::string name, std::string file, size_t line, size_t column) {
+    methods_.push_back(ProfiledMethod{std::move(name), std::move(file), line, column});
+    return static_cast<uint32_t>(methods_.size() - 1);
+}
+
+void Profiler::enterChild(uint32_t method) {
+    // A call site usually has few distinct callees, so a linear scan beats a map
+    uint32_t next = UINT32_MAX;
+    for (uint32_t child : nodes_[current_].children) {
+        if (nodes_[child].method == method) {
+            next = child;
+            break;
+        }
+    }
+    if (next == UINT32_MAX) {
+        next = static_cast<uint32_t>(nodes_.size());
+        nodes_.emplace_back(method, current_);
+        nodes_[current_].children.push_back(next);
+    }
+    nodes_[current_].lastMethod = method;
+    nodes_[current_].lastChild = next;
+    current_ = next;
+}
+
+size_t Profiler::depth() const {
+    size_t depth = 0;
+    for (uint32_t node = current_; node != ROOT; node = nodes_[node].parent) {
+        depth++;
+    }
+    return depth;
+}
+
+void Profiler::sample() {
+    countdown_ = interval_;
+    samples_++;
+    nodes_[current_].samples++;
+}
+
+void Profiler::sampleAfter(uint64_t instructions) {
+    // Every interval boundary crossed within the batch is a sample of the current stack
+    uint64_t past = instructions - countdown_;
+    uint64_t count = 1 + past / interval_;
+    countdown_ = interval_ - past % interval_;
+    samples_ += count;
+    nodes_[current_].samples += count;
+}
+
+std::vector<MethodProfile> Profiler::profile() const {
+    std::vector<MethodProfile> result(methods_.size());
+    for (uint32_t i = 0; i < result.size(); ++i) {
+        result[i].method = i;
+    }
+
+    // Children are created after their parent, so a reverse pass sums every subtree
+    std::vector<uint64_t> subtree(nodes_.size());
+    for (size_t i = nodes_.size(); i-- > 0;) {
+        subtree[i] += nodes_[i].samples;
+        if (i != ROOT) {
+            subtree[nodes_[i].parent] += subtree[i];
+        }
+    }
+
+    // Only the outermost frame of a method adds its subtree to the total
+    std::vector<uint32_t> active(methods_.size());
+    walk(nodes_,
+         [&](uint32_t node) {
+             if (node == ROOT) return;
+             uint32_t method = nodes_[node].method;
+             result[method].self += nodes_[node].samples;
+             if (active[method]++ == 0) {
+                 result[method].total += subtree[node];
+             }
+         },
+         [&](uint32_t node) {
+             if (node != ROOT) active[nodes_[node].method]--;
+         });
+
+    result.erase(std::remove_if(result.begin(), result.end(),
+                                [](const MethodProfile& entry) { return entry.total == 0; }),
+                 result.end());
+    std::stable_sort(result.begin(), result.end(), [](const MethodProfile& a, const MethodProfile& b) {
+        if (a.self != b.self) return a.self > b.self;
+        return a.total > b.total;
+    });
+    return result;
+}
+
+void Profiler::writeFolded(std::ostream& out) const {
+    // Samples taken outside any method have no frame to attribute them to
+    std::vector<const std::string*> path;
+    walk(nodes_,
+         [&](uint32_t node) {
+             if (node == ROOT) return;
+             path.push_back(&methods_[nodes_[node].method].name);
+             if (nodes_[node].samples == 0) return;
+             for (size_t i = 0; i < path.size(); ++i) {
+                 if (i > 0) out << ';';
+                 out << *path[i];
+             }
+             out << ' ' << nodes_[node].samples << '\n';
+         },
+         [&](uint32_t node) {
+             if (node != ROOT) path.pop_back();
+         });
+}
+
+void Profiler::writeTable(std::ostream& out) const {
+    std::vector<MethodProfile> entries = profile();
+
+    size_t width = 6;
+    for (const MethodProfile& entry : entries) {
+        width = std::max(width, methods_[entry.method].name.size());
+    }
+
+    std::ios_base::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << std::left << std::setw(static_cast<int>(width)) << "Method" << std::right
+        << std::setw(10) << "Self" << std::setw(8) << "Self%"
+        << std::setw(10) << "Total" << std::setw(8) << "Total%" << "  Location\n";
+    out << std::fixed << std::setprecision(1);
+    for (const MethodProfile& entry : entries) {
+        const ProfiledMethod& method = methods_[entry.method];
+        out << std::left << std::setw(static_cast<int>(width)) << method.name << std::right
+            << std::setw(10) << entry.self << std::setw(7) << percent(entry.self, samples_) << '%'
+            << std::setw(10) << entry.total << std::setw(7) << percent(entry.total, samples_) << '%'
+            << "  " << method.file << ':' << method.line << ':' << method.column << '\n';
+    }
+    out << "Samples: " << samples_ << '\n';
+    out.flags(flags);
+    out.precision(precision);
+}
+
+}
@@ -0,0 +1,101 @@
+#include "content_hash.h"
+#include "interface_file.h"
+#include "lexer.h"
+#include "semantic.h"
+#include "token_dump.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+
+std::string readFile(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open file: " + filename);
+    }
+    
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return buffer.str();
+}
+
+int main(int argc, char* argv[]) {
+    size_t threads = 1;
+    bool emitInterfaces = false;
+    std::vector<std::string> imports;
+    std::vector<std::string> files;
+    
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = std::stoul(argv[++i]);
+        } else if (std::strcmp(argv[i], "--import") == 0 && i + 1 < argc) {
+            imports.push_back(argv[++i]);
+        } else if (std::strcmp(argv[i], "--emit-interfaces") == 0) {
+            emitInterfaces = true;
+        } else {
+            files.push_back(argv[i]);
+        }
+    }
+    
+    if (files.empty()) {
+        std::cerr << "Usage: " << argv[0] << " [--threads <n>] [--import <file.oli>]... [--emit-interfaces] <source_file.ol>..." << std::endl;
+        return 1;
+    }
+    
+    try {
+        // All files form one program and share one constant pool
+        auto constants = std::make_shared<olang::ConstantPool>();
+        std::vector<olang::SourceUnit> units;
+        std::vector<uint64_t> hashes;
+        for (const auto& file : files) {
+            std::string source = readFile(file);
+            hashes.push_back(olang::contentHash(source));
+            olang::Lexer lexer(source, constants);
+            units.push_back(olang::SourceUnit{file, lexer.tokenize()});
+        }
+        
+        // Interface files are mapped, so they stay open until the analyzer is done
+        std::vector<std::unique_ptr<olang::InterfaceFile>> interfaces;
+        for (const auto& path : imports) {
+            interfaces.push_back(std::make_unique<olang::InterfaceFile>(path));
+        }
+        
+        std::unique_ptr<olang::ThreadPool> pool;
+        if (threads != 1) {
+            pool = std::make_unique<olang::ThreadPool>(threads);
+        }
+        
+        olang::SemanticAnalyzer analyzer(pool.get());
+        for (const auto& interface : interfaces) {
+            analyzer.addImport(*interface);
+        }
+        std::vector<olang::Diagnostic> diagnostics = analyzer.analyze(units);
+        
+        // Only a clean program gets interfaces; an unchanged source keeps its file
+        if (emitInterfaces && diagnostics.empty()) {
+            for (size_t unit = 0; unit < units.size(); ++unit) {
+                std::string path = std::filesystem::path(files[unit]).replace_extension(".oli").string();
+                if (olang::updateInterface(path, hashes[unit], analyzer.declarations(unit),
+                                           analyzer.importDependencies(unit))) {
+                    std::cout << "Wrote " << path << std::endl;
+                }
+            }
+        }
+        
+        for (const auto& diagnostic : diagnostics) {
+            std::cerr << diagnostic << std::endl;
+        }
+        std::cout << "Classes: " << analyzer.classCount() << ", errors: " << diagnostics.size() << std::endl;
+        
+        return diagnostics.empty() ? 0 : 1;
+        
+    } catch (const olang::LexerError& e) {
+        olang::dumpLexerError(std::cerr, e.what(), e.line(), e.column());
+        return 1;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
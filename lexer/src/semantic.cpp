@@ -0,0 +1,496 @@
+#include "semantic.h"
+#include <algorithm>
+#include <future>
+
+namespace olang {
+
+namespace {
+
+// Library classes of the specification, plus String, IO and Dictionary used by the examples
+const std::unordered_map<std::string, size_t> libraryClasses = {
+    {"Class", 0},
+    {"AnyValue", 0},
+    {"AnyRef", 0},
+    {"Integer", 0},
+    {"Real", 0},
+    {"Boolean", 0},
+    {"String", 0},
+    {"IO", 0},
+    {"Array", 1},
+    {"List", 1},
+    {"Dictionary", 2}
+};
+
+void report(std::vector<Diagnostic>& diagnostics, size_t line, size_t column, std::string message) {
+    diagnostics.push_back(Diagnostic{"", line, column, std::move(message)});
+}
+
+std::string returnTypeOf(const MethodDecl& method) {
+    return method.returnType ? method.returnType->toString() : "";
+}
+
+}
+
+std::ostream& operator<<(std::ostream& os, const Diagnostic& diagnostic) {
+    os << diagnostic.file << ":" << diagnostic.line << ":" << diagnostic.column
+       << ": error: " << diagnostic.message;
+    return os;
+}
+
+bool isLibraryClass(const std::string& name) {
+    return libraryClasses.count(name) > 0;
+}
+
+SemanticAnalyzer::SemanticAnalyzer(ThreadPool* pool) : pool_(pool) {}
+
+const ClassInfo* SemanticAnalyzer::findClass(const std::string& name) const {
+    auto it = classIndex_.find(name);
+    return it != classIndex_.end() ? &classes_[it->second] : nullptr;
+}
+
+template <typename F>
+void SemanticAnalyzer::parallelFor(size_t count, F body) {
+    size_t workers = pool_ ? pool_->size() : 1;
+    if (workers <= 1 || count < 2) {
+        for (size_t i = 0; i < count; ++i) {
+            body(i);
+        }
+        return;
+    }
+
+    // A few chunks per worker evens out classes of different size
+    size_t chunks = std::min(count, workers * 4);
+    std::vector<std::future<void>> pending;
+    pending.reserve(chunks);
+    for (size_t chunk = 0; chunk < chunks; ++chunk) {
+        size_t begin = count * chunk / chunks;
+        size_t end = count * (chunk + 1) / chunks;
+        pending.push_back(pool_->submit([&body, begin, end] {
+            for (size_t i = begin; i < end; ++i) {
+                body(i);
+            }
+        }));
+    }
+
+    for (auto& result : pending) {
+        result.wait();
+    }
+    for (auto& result : pending) {
+        result.get();
+    }
+}
+
+std::vector<Diagnostic> SemanticAnalyzer::analyze(const std::vector<SourceUnit>& units) {
+    declarations_.assign(units.size(), {});
+    importedDeclarations_.clear();
+    classes_.clear();
+    classIndex_.clear();
+
+    // Diagnostics of the declaration and inheritance passes, per unit
+    std::vector<std::vector<Diagnostic>> unitDiagnostics(units.size());
+
+    // Parsing walks every method body, so it runs per unit in parallel; a serial
+    // parse here would cap the speedup of the whole analysis
+    parallelFor(units.size(), [&](size_t unit) {
+        DeclarationParser parser(units[unit].tokens);
+        declarations_[unit] = parser.parse();
+        for (const ParseError& e : parser.errors()) {
+            report(unitDiagnostics[unit], e.line(), e.column(), e.what());
+        }
+    });
+
+    // Registration stays serial so that the first declaration of a name wins deterministically
+    for (size_t unit = 0; unit < units.size(); ++unit) {
+        for (const ClassDecl& decl : declarations_[unit]) {
+            if (classIndex_.count(decl.name) > 0) {
+                report(unitDiagnostics[unit], decl.line, decl.column, "Duplicate class '" + decl.name + "'");
+                continue;
+            }
+            classIndex_.emplace(decl.name, classes_.size());
+            ClassInfo info;
+            info.decl = &decl;
+            info.unit = unit;
+            classes_.push_back(std::move(info));
+        }
+    }
+
+    std::vector<std::vector<size_t>> levels = resolveInheritance(unitDiagnostics);
+
+    // Each class only writes its own entry and reads its base, which belongs to an earlier level
+    std::vector<std::vector<Diagnostic>> classDiagnostics(classes_.size());
+    for (const auto& level : levels) {
+        parallelFor(level.size(), [&](size_t i) {
+            collectMembers(level[i], classDiagnostics[level[i]]);
+        });
+    }
+
+    parallelFor(classes_.size(), [&](size_t i) {
+        checkClass(i, units[classes_[i].unit].tokens, classDiagnostics[i]);
+    });
+
+    std::vector<std::pair<size_t, Diagnostic>> located;
+    for (size_t unit = 0; unit < units.size(); ++unit) {
+        for (auto& diagnostic : unitDiagnostics[unit]) {
+            located.emplace_back(unit, std::move(diagnostic));
+        }
+    }
+    for (size_t i = 0; i < classes_.size(); ++i) {
+        if (classes_[i].imported) continue;
+        for (auto& diagnostic : classDiagnostics[i]) {
+            located.emplace_back(classes_[i].unit, std::move(diagnostic));
+        }
+    }
+
+    std::stable_sort(located.begin(), located.end(), [](const auto& a, const auto& b) {
+        if (a.first != b.first) return a.first < b.first;
+        if (a.second.line != b.second.line) return a.second.line < b.second.line;
+        return a.second.column < b.second.column;
+    });
+
+    std::vector<Diagnostic> diagnostics;
+    diagnostics.reserve(located.size());
+    for (auto& [unit, diagnostic] : located) {
+        diagnostic.file = units[unit].file;
+        diagnostics.push_back(std::move(diagnostic));
+    }
+    return diagnostics;
+}
+
+int SemanticAnalyzer::importClass(const std::string& name) {
+    for (const InterfaceFile* file : imports_) {
+        if (auto found = file->find(name)) {
+            importedDeclarations_.push_back(file->decode(*found));
+            int index = static_cast<int>(classes_.size());
+            ClassInfo info;
+            info.decl = &importedDeclarations_.back();
+            info.imported = true;
+            info.source = file;
+            classes_.push_back(std::move(info));
+            classIndex_.emplace(name, static_cast<size_t>(index));
+            return index;
+        }
+    }
+    return -1;
+}
+
+// Generic arity of an imported class, read from the index without decoding the record
+std::optional<size_t> SemanticAnalyzer::findImport(const std::string& name) const {
+    for (const InterfaceFile* file : imports_) {
+        if (auto found = file->find(name)) {
+            return file->genericCount(*found);
+        }
+    }
+    return std::nullopt;
+}
+
+std::vector<std::vector<size_t>> SemanticAnalyzer::resolveInheritance(
+    std::vector<std::vector<Diagnostic>>& diagnostics) {
+    // Imported bases are appended while iterating, so their own bases get resolved too
+    for (size_t i = 0; i < classes_.size(); ++i) {
+        if (!classes_[i].decl->base) continue;
+        const TypeRef& base = *classes_[i].decl->base;
+        auto it = classIndex_.find(base.name);
+        int index = it != classIndex_.end() ? static_cast<int>(it->second) : importClass(base.name);
+
+        ClassInfo& info = classes_[i];
+        if (index >= 0) {
+            info.base = index;
+        } else if (isLibraryClass(base.name)) {
+            info.opaqueBase = true;
+        } else if (!info.imported) {
+            report(diagnostics[info.unit], base.line, base.column, "Unknown base class '" + base.name + "'");
+        }
+    }
+
+    // Walk every chain once; a chain that runs into itself is a cycle and gets cut
+    enum class State { NEW, ACTIVE, DONE };
+    std::vector<State> state(classes_.size(), State::NEW);
+    std::vector<std::vector<size_t>> levels;
+
+    for (size_t start = 0; start < classes_.size(); ++start) {
+        std::vector<size_t> path;
+        int current = static_cast<int>(start);
+        while (current >= 0 && state[current] == State::NEW) {
+            state[current] = State::ACTIVE;
+            path.push_back(static_cast<size_t>(current));
+            current = classes_[current].base;
+        }
+
+        if (current >= 0 && state[current] == State::ACTIVE) {
+            auto cycleStart = std::find(path.begin(), path.end(), static_cast<size_t>(current));
+            for (auto it = cycleStart; it != path.end(); ++it) {
+                ClassInfo& info = classes_[*it];
+                if (info.imported) continue;
+                const TypeRef& base = *info.decl->base;
+                report(diagnostics[info.unit], base.line, base.column,
+                       "Inheritance cycle through class '" + info.decl->name + "'");
+            }
+            for (auto it = cycleStart; it != path.end(); ++it) {
+                classes_[*it].base = -1;
+            }
+        }
+
+        for (auto it = path.rbegin(); it != path.rend(); ++it) {
+            ClassInfo& info = classes_[*it];
+            info.depth = info.base >= 0 ? classes_[info.base].depth + 1 : 0;
+            state[*it] = State::DONE;
+        }
+    }
+
+    reportMissingImports(diagnostics);
+
+    for (size_t i = 0; i < classes_.size(); ++i) {
+        size_t depth = classes_[i].depth;
+        if (levels.size() <= depth) {
+            levels.resize(depth + 1);
+        }
+        levels[depth].push_back(i);
+    }
+    return levels;
+}
+
+// An imported class whose own base is not available would otherwise act as a
+// root without inherited members. The error goes to the program class that
+// imported it and names the needed interface file when that is recorded.
+void SemanticAnalyzer::reportMissingImports(std::vector<std::vector<Diagnostic>>& diagnostics) {
+    for (const ClassInfo& info : classes_) {
+        if (info.imported || info.base < 0 || !classes_[info.base].imported) continue;
+
+        // Cycles are already cut, so every chain ends
+        ClassInfo* root = &classes_[info.base];
+        while (root->base >= 0) {
+            root = &classes_[root->base];
+        }
+        if (!root->imported || !root->decl->base) continue;
+
+        const std::string& missing = root->decl->base->name;
+        if (isLibraryClass(missing)) continue;
+        if (classIndex_.count(missing) > 0) continue;  // resolved, but cut as part of a cycle
+
+        // Members of the missing base are unknown, so accesses to them are not reported again
+        root->opaqueBase = true;
+
+        std::string message = "Base class '" + missing + "' of imported class '" + root->decl->name + "'";
+        if (auto interface = root->source->dependency(missing)) {
+            message += " is defined in '" + *interface + "', which is not imported";
+        } else {
+            message += " is unknown";
+        }
+        const TypeRef& base = *info.decl->base;
+        report(diagnostics[info.unit], base.line, base.column, message);
+    }
+}
+
+std::vector<InterfaceDependency> SemanticAnalyzer::importDependencies(size_t unit) const {
+    std::vector<InterfaceDependency> dependencies;
+    for (const ClassDecl& decl : declarations_.at(unit)) {
+        auto it = classIndex_.find(decl.name);
+        if (it == classIndex_.end() || classes_[it->second].decl != &decl) continue;  // duplicate
+
+        int base = classes_[it->second].base;
+        if (base < 0 || !classes_[base].imported) continue;
+        InterfaceDependency dependency{classes_[base].decl->name, classes_[base].source->path()};
+        if (std::find(dependencies.begin(), dependencies.end(), dependency) == dependencies.end()) {
+            dependencies.push_back(std::move(dependency));
+        }
+    }
+    return dependencies;
+}
+
+void SemanticAnalyzer::collectMembers(size_t index, std::vector<Diagnostic>& diagnostics) {
+    ClassInfo& info = classes_[index];
+    const ClassDecl& decl = *info.decl;
+
+    if (info.base >= 0) {
+        const ClassInfo& base = classes_[info.base];
+        info.methods = base.methods;
+        info.fields = base.fields;
+        info.opaqueBase = info.opaqueBase || base.opaqueBase;
+    }
+
+    std::unordered_set<std::string> ownFields;
+    for (const FieldDecl& field : decl.fields) {
+        if (!ownFields.insert(field.name).second) {
+            report(diagnostics, field.line, field.column,
+                   "Duplicate field '" + field.name + "' in class '" + decl.name + "'");
+        }
+        info.fields.insert(field.name);
+    }
+
+    std::unordered_map<std::string, const MethodDecl*> ownMethods;
+    for (const MethodDecl& method : decl.methods) {
+        std::string signature = method.signature();
+
+        // A forward declaration may be completed once by a definition with the same signature
+        auto own = ownMethods.find(signature);
+        if (own != ownMethods.end()) {
+            const MethodDecl& previous = *own->second;
+            if (previous.body.has_value() == method.body.has_value()) {
+                report(diagnostics, method.line, method.column,
+                       "Duplicate method '" + signature + "' in class '" + decl.name + "'");
+            } else if (returnTypeOf(previous) != returnTypeOf(method)) {
+                report(diagnostics, method.line, method.column,
+                       "Method '" + signature + "' does not match its forward declaration");
+            }
+            continue;
+        }
+        ownMethods.emplace(signature, &method);
+
+        auto& overloads = info.methods[method.name];
+        auto inherited = std::find_if(overloads.begin(), overloads.end(), [&](const MethodDecl* candidate) {
+            return candidate->signature() == signature;
+        });
+        if (inherited == overloads.end()) {
+            overloads.push_back(&method);
+            continue;
+        }
+        if (returnTypeOf(**inherited) != returnTypeOf(method)) {
+            report(diagnostics, method.line, method.column,
+                   "Method '" + signature + "' in class '" + decl.name +
+                   "' changes the return type of the method it overrides");
+        }
+        *inherited = &method;
+    }
+
+    std::unordered_set<std::string> constructors;
+    for (const ConstructorDecl& constructor : decl.constructors) {
+        if (!constructors.insert(constructor.signature()).second) {
+            report(diagnostics, constructor.line, constructor.column,
+                   "Duplicate constructor '" + constructor.signature() + "' in class '" + decl.name + "'");
+        }
+    }
+}
+
+void SemanticAnalyzer::checkClass(size_t index, const std::vector<Token>& tokens,
+                                  std::vector<Diagnostic>& diagnostics) const {
+    const ClassInfo& info = classes_[index];
+    const ClassDecl& decl = *info.decl;
+    if (info.imported) {
+        return;
+    }
+
+    // The base name itself was checked while resolving inheritance
+    if (decl.base) {
+        for (const TypeRef& argument : decl.base->arguments) {
+            checkType(argument, info, diagnostics);
+        }
+        if (info.base >= 0) {
+            size_t expected = classes_[info.base].decl->genericParameters.size();
+            if (decl.base->arguments.size() != expected) {
+                report(diagnostics, decl.base->line, decl.base->column,
+                       "Class '" + decl.base->name + "' expects " + std::to_string(expected) +
+                       " type argument(s), got " + std::to_string(decl.base->arguments.size()));
+            }
+        }
+    }
+
+    for (const FieldDecl& field : decl.fields) {
+        if (field.type) {
+            checkType(*field.type, info, diagnostics);
+        }
+    }
+
+    for (const MethodDecl& method : decl.methods) {
+        for (const Parameter& parameter : method.parameters) {
+            checkType(parameter.type, info, diagnostics);
+        }
+        if (method.returnType) {
+            checkType(*method.returnType, info, diagnostics);
+        }
+        if (method.body) {
+            checkBody(*method.body, tokens, info, diagnostics);
+        }
+    }
+
+    for (const ConstructorDecl& constructor : decl.constructors) {
+        for (const Parameter& parameter : constructor.parameters) {
+            checkType(parameter.type, info, diagnostics);
+        }
+        checkBody(constructor.body, tokens, info, diagnostics);
+    }
+}
+
+void SemanticAnalyzer::checkType(const TypeRef& type, const ClassInfo& info,
+                                 std::vector<Diagnostic>& diagnostics) const {
+    const auto& generics = info.decl->genericParameters;
+    if (std::find(generics.begin(), generics.end(), type.name) != generics.end()) {
+        if (!type.arguments.empty()) {
+            report(diagnostics, type.line, type.column,
+                   "Type parameter '" + type.name + "' cannot take type arguments");
+        }
+        return;
+    }
+
+    size_t expected = 0;
+    bool strict = true;
+    auto it = classIndex_.find(type.name);
+    if (it != classIndex_.end()) {
+        expected = classes_[it->second].decl->genericParameters.size();
+    } else if (auto imported = findImport(type.name)) {
+        expected = *imported;
+    } else if (auto library = libraryClasses.find(type.name); library != libraryClasses.end()) {
+        // The specification also writes library generics without arguments, e.g. ': List'
+        expected = library->second;
+        strict = false;
+    } else {
+        report(diagnostics, type.line, type.column, "Unknown type '" + type.name + "'");
+        return;
+    }
+
+    if (type.arguments.size() != expected && (strict || !type.arguments.empty())) {
+        report(diagnostics, type.line, type.column,
+               "Class '" + type.name + "' expects " + std::to_string(expected) +
+               " type argument(s), got " + std::to_string(type.arguments.size()));
+    }
+    for (const TypeRef& argument : type.arguments) {
+        checkType(argument, info, diagnostics);
+    }
+}
+
+void SemanticAnalyzer::checkBody(const BodyRange& body, const std::vector<Token>& tokens,
+                                 const ClassInfo& info, std::vector<Diagnostic>& diagnostics) const {
+    // tokens[body.end] is the closing 'end' or the next member, which matches none of the patterns
+    auto at = [&](size_t index) -> TokenType {
+        return tokens[std::min(index, body.end)].type;
+    };
+    const ClassDecl& decl = *info.decl;
+
+    for (size_t i = body.begin; i < body.end; ++i) {
+        const Token& token = tokens[i];
+
+        if (token.type == TokenType::VAR && at(i + 1) == TokenType::IDENTIFIER && at(i + 2) == TokenType::COLON &&
+            at(i + 3) == TokenType::IDENTIFIER && at(i + 4) != TokenType::DOT) {
+            size_t pos = i + 3;
+            try {
+                checkType(DeclarationParser::parseType(tokens, pos), info, diagnostics);
+            } catch (const ParseError& e) {
+                report(diagnostics, e.line(), e.column(), e.what());
+            }
+        } else if (token.type == TokenType::THIS && at(i + 1) == TokenType::DOT &&
+                   at(i + 2) == TokenType::IDENTIFIER) {
+            const Token& name = tokens[i + 2];
+            bool isCall = at(i + 3) == TokenType::LPAREN;
+            bool known = info.methods.count(name.lexeme) > 0 || (!isCall && info.fields.count(name.lexeme) > 0);
+            if (!known && !info.opaqueBase) {
+                report(diagnostics, name.line, name.column,
+                       std::string(isCall ? "Unknown method '" : "Unknown member '") + name.lexeme +
+                       "' in class '" + decl.name + "'");
+            }
+        } else if (token.type == TokenType::BASE) {
+            if (!decl.base) {
+                report(diagnostics, token.line, token.column,
+                       "'base' used in class '" + decl.name + "', which has no base class");
+            } else if (info.base >= 0 && at(i + 1) == TokenType::DOT && at(i + 2) == TokenType::IDENTIFIER) {
+                const ClassInfo& base = classes_[info.base];
+                const Token& name = tokens[i + 2];
+                bool known = base.methods.count(name.lexeme) > 0 || base.fields.count(name.lexeme) > 0;
+                if (!known && !base.opaqueBase) {
+                    report(diagnostics, name.line, name.column,
+                           "Unknown member '" + name.lexeme + "' in base class '" + base.decl->name + "'");
+                }
+            }
+        }
+    }
+}
+
+}
@@ -0,0 +1,35 @@
+#include "compile_server.h"
+#include <cstring>
+#include <iostream>
+#include <string>
+
+int main(int argc, char* argv[]) {
+    std::string socketPath;
+    size_t threads = 0;
+    
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--socket") == 0 && i + 1 < argc) {
+            socketPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = std::stoul(argv[++i]);
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--socket <path>] [--threads <n>]" << std::endl;
+            return 1;
+        }
+    }
+    
+    try {
+        if (socketPath.empty()) {
+            socketPath = olang::defaultSocketPath();
+        }
+        olang::CompileServer server(socketPath, threads);
+        server.listen();
+        std::cout << "Listening on " << socketPath << std::endl;
+        server.serve();
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    
+    return 0;
+}
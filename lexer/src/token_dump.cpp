@@ -0,0 +1,22 @@
+#include "token_dump.h"
+
+namespace olang {
+
+void dumpTokens(std::ostream& os, const std::string& filename, const std::vector<Token>& tokens) {
+    os << "Tokenizing file: " << filename << std::endl;
+    os << std::string(50, '=') << std::endl;
+    
+    for (const auto& token : tokens) {
+        os << token << std::endl;
+    }
+    
+    os << std::string(50, '=') << std::endl;
+    os << "Total tokens: " << tokens.size() << std::endl;
+}
+
+void dumpLexerError(std::ostream& os, const std::string& message, size_t line, size_t column) {
+    os << "Lexer error at " << line << ":" << column 
+       << " - " << message << std::endl;
+}
+
+}
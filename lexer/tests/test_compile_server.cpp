@@ -0,0 +1,208 @@
+#include "compile_server.h"
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+fs::path writeSource(const fs::path& path, const std::string& content) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << content;
+    return path;
+}
+
+void testCacheInvalidation() {
+    std::cout << "Testing cache invalidation..." << std::endl;
+    
+    fs::path path = fs::temp_directory_path() / ("olexer_cache_" + std::to_string(::getpid()) + ".ol");
+    writeSource(path, "class A is end");
+    
+    olang::CompileCache cache;
+    auto first = cache.lex(path.string());
+    assert(first->tokens.size() == 5);
+    assert(cache.misses() == 1);
+    
+    auto second = cache.lex(path.string());
+    assert(second == first);
+    assert(cache.hits() == 1);
+    
+    // Touched but unchanged: the hash keeps the entry
+    fs::last_write_time(path, fs::last_write_time(path) + std::chrono::seconds(5));
+    auto touched = cache.lex(path.string());
+    assert(touched == first);
+    assert(cache.misses() == 1);
+    
+    writeSource(path, "class B extends A is end");
+    fs::last_write_time(path, fs::last_write_time(path) + std::chrono::seconds(10));
+    auto changed = cache.lex(path.string());
+    assert(changed != first);
+    assert(changed->tokens.size() == 7);
+    assert(cache.misses() == 2);
+    
+    writeSource(path, "class \"broken");
+    fs::last_write_time(path, fs::last_write_time(path) + std::chrono::seconds(15));
+    auto broken = cache.lex(path.string());
+    assert(broken->failed);
+    assert(broken->error == "Unterminated string literal");
+    
+    fs::remove(path);
+    bool threw = false;
+    try {
+        cache.lex(path.string());
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    if (!threw) {
+        throw std::runtime_error("lexing a removed file did not fail");
+    }
+    
+    std::cout << "  ✓ Cache invalidation test passed" << std::endl;
+}
+
+void testServerRoundTrip() {
+    std::cout << "Testing server round trip..." << std::endl;
+    
+    std::string pid = std::to_string(::getpid());
+    fs::path socketPath = fs::temp_directory_path() / ("olexer_test_" + pid + ".sock");
+    fs::path source = writeSource(fs::temp_directory_path() / ("olexer_server_" + pid + ".ol"),
+                                  "class Main is\n    var x: Integer(42)\nend\n");
+    
+    olang::CompileServer server(socketPath.string(), 4);
+    server.listen();
+    std::thread serving([&server] { server.serve(); });
+    
+    // Concurrent clients for the same file all get the same answer
+    std::vector<std::thread> clients;
+    std::vector<std::string> responses(8);
+    for (size_t i = 0; i < responses.size(); ++i) {
+        clients.emplace_back([&, i] {
+            [[maybe_unused]] bool sent = olang::sendRequest(socketPath.string(), "LEX " + source.string(), responses[i]);
+            assert(sent);
+        });
+    }
+    for (auto& client : clients) {
+        client.join();
+    }
+    for ([[maybe_unused]] const auto& response : responses) {
+        assert(response == responses[0]);
+    }
+    assert(responses[0].rfind("OK\n", 0) == 0);
+    assert(responses[0].find("INTEGER_LITERAL '42'") != std::string::npos);
+    assert(responses[0].find("Total tokens: 12") != std::string::npos);
+    assert(server.cache().hits() + server.cache().misses() == responses.size());
+    
+    // Requests are sent outside assert() so they still run under NDEBUG
+    std::string named;
+    [[maybe_unused]] bool answered = olang::sendRequest(socketPath.string(), "LEX " + source.string() + "\tmain.ol", named);
+    assert(answered);
+    assert(named.find("Tokenizing file: main.ol\n") != std::string::npos);
+    assert(named.substr(named.find("\n=")) == responses[0].substr(responses[0].find("\n=")));
+    
+    // Class declarations come from the same cache entry as the tokens
+    [[maybe_unused]] size_t misses = server.cache().misses();
+    std::string classes;
+    answered = olang::sendRequest(socketPath.string(), "CLASSES " + source.string() + "\tmain.ol", classes);
+    assert(answered);
+    assert(classes == "OK\nclass Main\n  var x : Integer\n");
+    assert(server.cache().misses() == misses);
+    
+    std::string missing;
+    answered = olang::sendRequest(socketPath.string(), "LEX /nonexistent/file.ol", missing);
+    assert(answered);
+    assert(missing.rfind("FAIL\n", 0) == 0);
+    
+    std::string stats;
+    answered = olang::sendRequest(socketPath.string(), "STATS", stats);
+    assert(answered);
+    assert(stats.find("files: 1") != std::string::npos);
+    
+    std::string bye;
+    answered = olang::sendRequest(socketPath.string(), "SHUTDOWN", bye);
+    assert(answered);
+    assert(bye == "OK\n");
+    serving.join();
+    
+    fs::remove(source);
+    
+    std::cout << "  ✓ Server round trip test passed" << std::endl;
+}
+
+void testStalledClient() {
+    std::cout << "Testing stalled client timeout..." << std::endl;
+    
+    fs::path socketPath = fs::temp_directory_path() / ("olexer_stall_" + std::to_string(::getpid()) + ".sock");
+    olang::CompileServer server(socketPath.string(), 1);
+    server.setIoTimeout(std::chrono::milliseconds(200));
+    server.listen();
+    std::thread serving([&server] { server.serve(); });
+    
+    // Connects and never sends the request line, occupying the only worker
+    int idle = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+    if (::connect(idle, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        throw std::runtime_error("could not connect the idle client");
+    }
+    
+    std::string stats;
+    [[maybe_unused]] bool answered = olang::sendRequest(socketPath.string(), "STATS", stats);
+    assert(answered);
+    assert(stats.rfind("OK\n", 0) == 0);
+    ::close(idle);
+    
+    // A client trickling bytes faster than the timeout still runs into the overall deadline
+    int trickle = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (::connect(trickle, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        throw std::runtime_error("could not connect the trickling client");
+    }
+    bool dropped = false;
+    for (int i = 0; i < 60 && !dropped; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        dropped = ::send(trickle, "S", 1, MSG_NOSIGNAL) < 0;
+    }
+    ::close(trickle);
+    
+    // An endless request line is cut off instead of buffered
+    std::string oversized;
+    answered = olang::sendRequest(socketPath.string(), "LEX " + std::string(100000, 'a'), oversized);
+    assert(!answered || oversized.empty());
+    answered = olang::sendRequest(socketPath.string(), "STATS", stats);
+    assert(answered && stats.rfind("OK\n", 0) == 0);
+    
+    // stop() from outside the pool must wake serve() as well
+    server.stop();
+    serving.join();
+    if (!dropped) {
+        throw std::runtime_error("trickling client was never disconnected");
+    }
+    
+    std::cout << "  ✓ Stalled client test passed" << std::endl;
+}
+
+int main() {
+    std::cout << "Running compile server tests..." << std::endl;
+    std::cout << std::string(50, '=') << std::endl;
+    
+    try {
+        testCacheInvalidation();
+        testServerRoundTrip();
+        testStalledClient();
+        
+        std::cout << std::string(50, '=') << std::endl;
+        std::cout << "All tests passed! ✓" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed: " << e.what() << std::endl;
+        return 1;
+    }
+}
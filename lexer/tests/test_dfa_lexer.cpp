@@ -0,0 +1,135 @@
+#include "lexer.h"
+#include "dfa_lexer.h"
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#ifndef OLANG_EXAMPLES_DIR
+#error "OLANG_EXAMPLES_DIR must point to the directory with example .ol files"
+#endif
+
+// Outcome of running one engine: its tokens, or the error it stopped with
+struct Outcome {
+    std::vector<olang::Token> tokens;
+    bool failed = false;
+    std::string message;
+    size_t line = 0;
+    size_t column = 0;
+};
+
+template <typename Engine>
+Outcome run(const std::string& source) {
+    Outcome outcome;
+    try {
+        Engine engine(source);
+        outcome.tokens = engine.tokenize();
+    } catch (const olang::LexerError& e) {
+        outcome.failed = true;
+        outcome.message = e.what();
+        outcome.line = e.line();
+        outcome.column = e.column();
+    }
+    return outcome;
+}
+
+void assertSameTokens(const std::string& source) {
+    Outcome expected = run<olang::Lexer>(source);
+    Outcome actual = run<olang::DfaLexer>(source);
+    
+    assert(expected.failed == actual.failed);
+    assert(expected.message == actual.message);
+    assert(expected.line == actual.line);
+    assert(expected.column == actual.column);
+    assert(expected.tokens.size() == actual.tokens.size());
+    
+    for (size_t i = 0; i < expected.tokens.size(); ++i) {
+        [[maybe_unused]] const olang::Token& a = expected.tokens[i];
+        [[maybe_unused]] const olang::Token& b = actual.tokens[i];
+        assert(a.type == b.type);
+        assert(a.lexeme == b.lexeme);
+        assert(a.value == b.value);
+        assert(a.line == b.line);
+        assert(a.column == b.column);
+        assert(a.constant == b.constant);
+    }
+}
+
+void testExampleFiles() {
+    std::cout << "Testing example files against Lexer..." << std::endl;
+    
+    size_t count = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(OLANG_EXAMPLES_DIR)) {
+        if (entry.path().extension() != ".ol") {
+            continue;
+        }
+        std::ifstream file(entry.path());
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        assertSameTokens(buffer.str());
+        count++;
+    }
+    assert(count > 0);
+    
+    std::cout << "  ✓ " << count << " example files match" << std::endl;
+}
+
+void testEdgeCases() {
+    std::cout << "Testing edge cases against Lexer..." << std::endl;
+    
+    const char* sources[] = {
+        "",
+        "   \n\t ",
+        "classy class_ is1 iss end",
+        "12. 12.5.3 3abc 007 0.",
+        "a:=b=>c:d=e",
+        "x // trailing comment",
+        "/*/* a */ b */ y",
+        "\"line\nbreak\" z",
+        "\"esc\\\\\" \"\\\"\" \"\\q\"",
+        "/ x",
+        "x @ y",
+        "\"unterminated",
+        "\"ends with backslash\\",
+        "/* never closed",
+        "1 99999999999999999999",
+        "\n  1.5e"
+    };
+    
+    for (const char* source : sources) {
+        assertSameTokens(source);
+    }
+    
+    std::cout << "  ✓ Edge cases match" << std::endl;
+}
+
+void testTableSize() {
+    std::cout << "Testing DFA table size..." << std::endl;
+    
+    assert(olang::DfaLexer::byteClassCount() < 256);
+    assert(olang::DfaLexer::stateCount() > 2);
+    std::cout << "  " << olang::DfaLexer::stateCount() << " states, "
+              << olang::DfaLexer::byteClassCount() << " byte classes" << std::endl;
+    
+    std::cout << "  ✓ DFA table size test passed" << std::endl;
+}
+
+int main() {
+    std::cout << "Running DFA lexer tests..." << std::endl;
+    std::cout << std::string(50, '=') << std::endl;
+    
+    try {
+        testExampleFiles();
+        testEdgeCases();
+        testTableSize();
+        
+        std::cout << std::string(50, '=') << std::endl;
+        std::cout << "All tests passed! ✓" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed: " << e.what() << std::endl;
+        return 1;
+    }
+}
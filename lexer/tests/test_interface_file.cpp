@@ -0,0 +1,304 @@
+#include "content_hash.h"
+#include "interface_file.h"
+#include "lexer.h"
+#include "semantic.h"
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+const std::string ANIMALS = R"(
+    class Animal is
+        var name : String("animal")
+        method Speak() : String is
+            return name
+        end
+        method Rename(n : String)
+        this(n : String) is
+            name := n
+        end
+    end
+
+    class Box<T> is
+        var item : T
+        method Get() : T => item
+    end
+
+    class Zoo extends Animal is
+        var boxes : List<Box<Animal>>
+    end
+)";
+
+std::vector<olang::ClassDecl> parse(const std::string& source) {
+    olang::Lexer lexer(source);
+    std::vector<olang::Token> tokens = lexer.tokenize();
+    olang::DeclarationParser parser(tokens);
+    std::vector<olang::ClassDecl> classes = parser.parse();
+    assert(parser.errors().empty());
+    return classes;
+}
+
+fs::path scratchFile(const std::string& name) {
+    return fs::temp_directory_path() / ("olang_test_" + name);
+}
+
+void writeBytes(const fs::path& path, const std::vector<uint8_t>& bytes) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+}
+
+void testRoundTrip() {
+    std::cout << "Testing interface round trip..." << std::endl;
+
+    std::vector<olang::ClassDecl> classes = parse(ANIMALS);
+    fs::path path = scratchFile("round_trip.oli");
+    olang::InterfaceFile::write(path.string(), 42, classes, {{"Creature", "creatures.oli"}});
+
+    olang::InterfaceFile file(path.string());
+    assert(file.path() == path.string());
+    assert(file.sourceHash() == 42);
+    assert(file.dependencies().size() == 1);
+    assert(file.dependency("Creature") == std::optional<std::string>("creatures.oli"));
+    assert(!file.dependency("Animal"));
+    assert(file.classCount() == 3);
+
+    // The index is sorted by name, independent of declaration order
+    assert(file.className(0) == "Animal");
+    assert(file.className(1) == "Box");
+    assert(file.className(2) == "Zoo");
+    assert(file.genericCount(*file.find("Box")) == 1);
+    assert(!file.find("Cat"));
+
+    olang::ClassDecl animal = file.decode(*file.find("Animal"));
+    assert(animal.name == "Animal");
+    assert(animal.line == classes[0].line && animal.column == classes[0].column);
+    assert(animal.fields.size() == 1 && animal.fields[0].type->name == "String");
+    assert(animal.methods.size() == 2);
+    assert(animal.methods[0].signature() == "Speak()" && animal.methods[0].body);
+    assert(animal.methods[1].signature() == "Rename(String)" && !animal.methods[1].body);
+    assert(animal.constructors.size() == 1 && animal.constructors[0].signature() == "this(String)");
+
+    olang::ClassDecl zoo = file.decode(*file.find("Zoo"));
+    assert(zoo.base && zoo.base->name == "Animal");
+    assert(zoo.fields[0].type->toString() == "List<Box<Animal>>");
+
+    fs::remove(path);
+    std::cout << "  ✓ Round trip test passed" << std::endl;
+}
+
+void testUpdateSkipsUnchangedSource() {
+    std::cout << "Testing content-hash rebuild check..." << std::endl;
+
+    std::vector<olang::ClassDecl> classes = parse(ANIMALS);
+    fs::path path = scratchFile("update.oli");
+    fs::remove(path);
+
+    // Writes happen outside assert() so the test still runs under NDEBUG
+    uint64_t hash = olang::contentHash(ANIMALS);
+    [[maybe_unused]] bool written = olang::updateInterface(path.string(), hash, classes);
+    assert(written);
+    written = olang::updateInterface(path.string(), hash, classes);
+    assert(!written);
+    written = olang::updateInterface(path.string(), olang::contentHash(ANIMALS + " "), classes);
+    assert(written);
+
+    // Same source, but a base now comes from another interface
+    std::vector<olang::InterfaceDependency> dependencies{{"Base", "base.oli"}};
+    written = olang::updateInterface(path.string(), hash, classes, dependencies);
+    assert(written);
+    written = olang::updateInterface(path.string(), hash, classes, dependencies);
+    assert(!written);
+
+    // A damaged file is rebuilt rather than trusted
+    writeBytes(path, {'O', 'L', 'I', 'F'});
+    written = olang::updateInterface(path.string(), hash, classes);
+    assert(written);
+    olang::InterfaceFile rebuilt(path.string());
+    assert(rebuilt.sourceHash() == hash);
+    assert(rebuilt.dependencies().empty());
+
+    fs::remove(path);
+    std::cout << "  ✓ Rebuild check test passed" << std::endl;
+}
+
+bool rejects(const fs::path& path) {
+    try {
+        olang::InterfaceFile file(path.string());
+        for (size_t i = 0; i < file.classCount(); ++i) {
+            file.decode(i);
+        }
+        return false;
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+}
+
+void testMalformedFiles() {
+    std::cout << "Testing malformed interface files..." << std::endl;
+
+    std::vector<uint8_t> bytes = olang::InterfaceFile::encode(7, parse(ANIMALS));
+    fs::path path = scratchFile("malformed.oli");
+
+    assert(rejects(scratchFile("missing.oli")));
+
+    std::vector<uint8_t> badMagic = bytes;
+    badMagic[0] = 'X';
+    writeBytes(path, badMagic);
+    assert(rejects(path));
+
+    std::vector<uint8_t> badVersion = bytes;
+    badVersion[4] = 99;
+    writeBytes(path, badVersion);
+    assert(rejects(path));
+
+    // Every truncation must be caught by the header check or the record decoder
+    for (size_t size = 0; size < bytes.size(); ++size) {
+        writeBytes(path, std::vector<uint8_t>(bytes.begin(), bytes.begin() + size));
+        assert(rejects(path));
+    }
+
+    writeBytes(path, bytes);
+    assert(!rejects(path));
+
+    fs::remove(path);
+    std::cout << "  ✓ Malformed file test passed" << std::endl;
+}
+
+void testAnalysisAgainstImports() {
+    std::cout << "Testing analysis against imported interfaces..." << std::endl;
+
+    fs::path path = scratchFile("import.oli");
+    olang::InterfaceFile::write(path.string(), 1, parse(ANIMALS));
+    olang::InterfaceFile library(path.string());
+
+    std::string source = R"(
+        class Cat extends Animal is
+            var home : Box<Cat>
+            method Speak() : String is
+                return "meow"
+            end
+            method Play() is
+                Rename("cat")
+            end
+        end
+        class Broken is
+            var a : Box
+            var b : Missing
+        end
+    )";
+    olang::Lexer lexer(source);
+    std::vector<olang::SourceUnit> units{olang::SourceUnit{"cat.ol", lexer.tokenize()}};
+
+    olang::SemanticAnalyzer analyzer;
+    analyzer.addImport(library);
+    std::vector<olang::Diagnostic> diagnostics = analyzer.analyze(units);
+
+    // Only the base chain is decoded; Box is checked through the index alone
+    [[maybe_unused]] const olang::ClassInfo* cat = analyzer.findClass("Cat");
+    assert(cat && cat->base >= 0);
+    assert(cat->methods.count("Rename") == 1 && cat->fields.count("name") == 1);
+    assert(analyzer.findClass("Animal")->imported);
+    assert(!analyzer.findClass("Box") && !analyzer.findClass("Zoo"));
+    assert(analyzer.classCount() == 3);
+
+    assert(diagnostics.size() == 2);
+    assert(diagnostics[0].message.find("'Box'") != std::string::npos);
+    assert(diagnostics[1].message == "Unknown type 'Missing'");
+
+    // Without the import the same program fails to resolve its base
+    olang::SemanticAnalyzer plain;
+    std::vector<olang::Diagnostic> unresolved = plain.analyze(units);
+    assert(unresolved.size() > diagnostics.size());
+    assert(unresolved[0].message == "Unknown base class 'Animal'");
+
+    fs::remove(path);
+    std::cout << "  ✓ Import test passed" << std::endl;
+}
+
+void testMissingTransitiveImport() {
+    std::cout << "Testing missing transitive imports..." << std::endl;
+
+    // animals.oli <- cat.oli <- program; only cat.oli is imported
+    fs::path animals = scratchFile("animals.oli");
+    olang::InterfaceFile::write(animals.string(), 1, parse(ANIMALS));
+    olang::InterfaceFile animalsFile(animals.string());
+
+    std::string catSource = R"(
+        class Cat extends Animal is
+            method Speak() : String is
+                return "meow"
+            end
+        end
+    )";
+    olang::Lexer catLexer(catSource);
+    std::vector<olang::SourceUnit> catUnits{olang::SourceUnit{"cat.ol", catLexer.tokenize()}};
+    olang::SemanticAnalyzer catAnalyzer;
+    catAnalyzer.addImport(animalsFile);
+    [[maybe_unused]] auto catDiagnostics = catAnalyzer.analyze(catUnits);
+    assert(catDiagnostics.empty());
+
+    std::vector<olang::InterfaceDependency> dependencies = catAnalyzer.importDependencies(0);
+    assert(dependencies.size() == 1);
+    assert(dependencies[0].className == "Animal" && dependencies[0].interface == animals.string());
+    fs::path cat = scratchFile("cat.oli");
+    olang::InterfaceFile::write(cat.string(), 2, catAnalyzer.declarations(0), dependencies);
+    olang::InterfaceFile catFile(cat.string());
+
+    std::string source = R"(
+        class Kitten extends Cat is
+            method Name() : String is
+                return this.name
+            end
+        end
+        class Tiger extends Cat is
+        end
+    )";
+    olang::Lexer lexer(source);
+    std::vector<olang::SourceUnit> units{olang::SourceUnit{"kitten.ol", lexer.tokenize()}};
+
+    // Each class that pulls Cat in is told which interface is missing; no follow-up member errors
+    olang::SemanticAnalyzer analyzer;
+    analyzer.addImport(catFile);
+    std::vector<olang::Diagnostic> diagnostics = analyzer.analyze(units);
+    assert(diagnostics.size() == 2);
+    std::string expected = "Base class 'Animal' of imported class 'Cat' is defined in '" + animals.string() +
+                           "', which is not imported";
+    assert(diagnostics[0].line == 2 && diagnostics[0].message == expected);
+    assert(diagnostics[1].line == 7 && diagnostics[1].message == expected);
+
+    olang::SemanticAnalyzer complete;
+    complete.addImport(catFile);
+    complete.addImport(animalsFile);
+    diagnostics = complete.analyze(units);
+    assert(diagnostics.empty());
+    assert(complete.findClass("Kitten")->fields.count("name") == 1);
+
+    fs::remove(animals);
+    fs::remove(cat);
+    std::cout << "  ✓ Missing import test passed" << std::endl;
+}
+
+int main() {
+    std::cout << "Running interface file tests..." << std::endl;
+    std::cout << std::string(50, '=') << std::endl;
+
+    try {
+        testRoundTrip();
+        testUpdateSkipsUnchangedSource();
+        testMalformedFiles();
+        testAnalysisAgainstImports();
+        testMissingTransitiveImport();
+
+        std::cout << std::string(50, '=') << std::endl;
+        std::cout << "All tests passed! ✓" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -1,3 +1,4 @@
+#include "constant_pool.h"
 #include "lexer.h"
 #include <cassert>
 #include <iostream>
@@ -89,6 +90,97 @@ void testStrings() {
     std::cout << "  ✓ Strings test passed" << std::endl;
 }
 
+void testLiteralDecoding() {
+    std::cout << "Testing literal decoding..." << std::endl;
+    
+    olang::Lexer lexer("0.1 9223372036854775807 2.5e3 \"tab\\there\" \"\\q\"");
+    auto tokens = lexer.tokenize();
+    
+    assert(tokens.size() == 7);
+    assert(std::get<double>(tokens[0].value) == 0.1);
+    assert(std::get<int64_t>(tokens[1].value) == INT64_MAX);
+    // "2.5e3" has no exponent syntax: it is 2.5 followed by identifier e3
+    assert(std::get<double>(tokens[2].value) == 2.5);
+    assert(tokens[3].type == olang::TokenType::IDENTIFIER);
+    assert(std::get<std::string>(tokens[4].value) == "tab\there");
+    assert(std::get<std::string>(tokens[5].value) == "\\q");
+    
+    std::cout << "  ✓ Literal decoding test passed" << std::endl;
+}
+
+void testLiteralOverflow() {
+    std::cout << "Testing literal overflow..." << std::endl;
+    
+    try {
+        olang::Lexer lexer("var x := 99999999999999999999");
+        lexer.tokenize();
+        assert(false);
+    } catch (const olang::LexerError& e) {
+        assert(e.line() == 1);
+        assert(e.column() == 10);
+    }
+    
+    try {
+        olang::Lexer lexer("\n  1" + std::string(400, '0') + ".5");
+        lexer.tokenize();
+        assert(false);
+    } catch (const olang::LexerError& e) {
+        assert(e.line() == 2);
+        assert(e.column() == 3);
+    }
+    
+    std::cout << "  ✓ Literal overflow test passed" << std::endl;
+}
+
+void testConstantPool() {
+    std::cout << "Testing constant pool..." << std::endl;
+    
+    olang::Lexer lexer(R"(0 1 0 1.5 "a" 1 "a" 1.5 "b")");
+    auto tokens = lexer.tokenize();
+    
+    assert(lexer.constants().size() == 5);
+    assert(tokens[0].constant == tokens[2].constant);
+    assert(tokens[1].constant == tokens[5].constant);
+    assert(tokens[3].constant == tokens[7].constant);
+    assert(tokens[4].constant == tokens[6].constant);
+    assert(tokens[4].constant != tokens[8].constant);
+    assert(tokens[0].constant != tokens[1].constant);
+    assert(std::get<std::string>(lexer.constants().at(tokens[8].constant)) == "b");
+    assert(std::get<int64_t>(lexer.constants().at(tokens[1].constant)) == 1);
+    assert(tokens[9].constant == olang::NO_CONSTANT);
+    
+    // Booleans are literals too: every true shares one slot, distinct from false
+    olang::Lexer flags("true false true x", lexer.sharedConstants());
+    auto bools = flags.tokenize();
+    assert(bools[0].constant == bools[2].constant);
+    assert(bools[0].constant != bools[1].constant);
+    assert(std::get<bool>(lexer.constants().at(bools[0].constant)));
+    assert(!std::get<bool>(lexer.constants().at(bools[1].constant)));
+    assert(bools[3].constant == olang::NO_CONSTANT);
+    assert(lexer.constants().size() == 7);
+    
+    // A second file of the same compilation reuses the pool
+    olang::Lexer other("1 \"b\" 7", lexer.sharedConstants());
+    auto more = other.tokenize();
+    assert(more[0].constant == tokens[1].constant);
+    assert(more[1].constant == tokens[8].constant);
+    assert(lexer.constants().size() == 8);
+    
+    // Short strings live inside the pool's slots; growing the pool must not invalidate lookups
+    olang::ConstantPool pool;
+    for (int i = 0; i < 1000; ++i) {
+        [[maybe_unused]] uint32_t slot = pool.intern(std::to_string(i));
+        assert(slot == static_cast<uint32_t>(i));
+    }
+    for (int i = 0; i < 1000; ++i) {
+        [[maybe_unused]] uint32_t slot = pool.intern(std::to_string(i));
+        assert(slot == static_cast<uint32_t>(i));
+    }
+    assert(pool.size() == 1000);
+    
+    std::cout << "  ✓ Constant pool test passed" << std::endl;
+}
+
 void testOperators() {
     std::cout << "Testing operators..." << std::endl;
     
@@ -215,6 +307,9 @@ int main() {
         testIdentifiers();
         testNumbers();
         testStrings();
+        testLiteralDecoding();
+        testLiteralOverflow();
+        testConstantPool();
         testOperators();
         testComments();
         testNestedComments();
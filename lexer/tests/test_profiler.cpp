@@ -0,0 +1,236 @@
+#include "declarations.h"
+#include "lexer.h"
+#include "profiler.h"
+#include <cassert>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+#ifndef OLANG_EXAMPLES_DIR
+#error "OLANG_EXAMPLES_DIR must point to the directory with example .ol files"
+#endif
+
+std::map<std::string, uint64_t> parseFolded(const std::string& folded) {
+    std::map<std::string, uint64_t> stacks;
+    std::istringstream in(folded);
+    std::string line;
+    while (std::getline(in, line)) {
+        size_t space = line.rfind(' ');
+        assert(space != std::string::npos);
+        stacks[line.substr(0, space)] += std::stoull(line.substr(space + 1));
+    }
+    return stacks;
+}
+
+const olang::MethodProfile& entry(const std::vector<olang::MethodProfile>& profile, uint32_t method) {
+    for (const auto& e : profile) {
+        if (e.method == method) return e;
+    }
+    throw std::runtime_error("method not in profile");
+}
+
+void testExactCounts() {
+    std::cout << "Testing sample attribution..." << std::endl;
+
+    olang::Profiler profiler(1);
+    uint32_t main = profiler.addMethod("Main.this", "a.ol", 1, 5);
+    uint32_t fib = profiler.addMethod("Main.fib", "a.ol", 2, 12);
+    uint32_t pred = profiler.addMethod("Main.pred", "a.ol", 3, 12);
+
+    profiler.enter(main);
+    profiler.tick();                     // Main.this
+    profiler.enter(fib);
+    profiler.tick();                     // Main.this;Main.fib
+    profiler.enter(fib);
+    profiler.tick();
+    profiler.tick();                     // Main.this;Main.fib;Main.fib x2
+    profiler.enter(pred);
+    profiler.tick();                     // ...;Main.fib;Main.pred
+    assert(profiler.depth() == 4);
+    profiler.leave();
+    profiler.leave();
+    profiler.enter(pred);
+    profiler.tick();                     // Main.this;Main.fib;Main.pred
+    profiler.leave();
+    profiler.leave();
+    profiler.leave();
+    assert(profiler.depth() == 0);
+    assert(profiler.sampleCount() == 6);
+
+    std::ostringstream folded;
+    profiler.writeFolded(folded);
+    assert(folded.str() ==
+           "Main.this 1\n"
+           "Main.this;Main.fib 1\n"
+           "Main.this;Main.fib;Main.fib 2\n"
+           "Main.this;Main.fib;Main.fib;Main.pred 1\n"
+           "Main.this;Main.fib;Main.pred 1\n");
+
+    auto profile = profiler.profile();
+    assert(profile.size() == 3);
+    assert(profile[0].method == fib);
+    assert(entry(profile, fib).self == 3 && entry(profile, fib).total == 5);  // recursion counted once
+    assert(entry(profile, pred).self == 2 && entry(profile, pred).total == 2);
+    assert(entry(profile, main).self == 1 && entry(profile, main).total == 6);
+
+    std::ostringstream table;
+    profiler.writeTable(table);
+    assert(table.str().find("Main.fib") != std::string::npos);
+    assert(table.str().find("a.ol:2:12") != std::string::npos);
+    assert(table.str().find("Samples: 6") != std::string::npos);
+
+    // A batch of instructions samples exactly where single ticks would
+    olang::Profiler single(4);
+    olang::Profiler batched(4);
+    single.enter(single.addMethod("Main.this", "a.ol", 1, 5));
+    batched.enter(batched.addMethod("Main.this", "a.ol", 1, 5));
+    for (int i = 0; i < 10; ++i) single.tick();
+    batched.tick(10);
+    assert(single.sampleCount() == 2 && batched.sampleCount() == 2);
+    single.tick();
+    single.tick();
+    batched.tick(1);
+    batched.tick(1);
+    assert(batched.sampleCount() == 3 && single.sampleCount() == 3);
+    batched.tick(3);
+    assert(batched.sampleCount() == 3);
+    batched.tick(9);
+    assert(batched.sampleCount() == 6);
+    batched.leave();
+    assert(batched.profile()[0].self == 6);
+
+    std::cout << "  ✓ Sample attribution test passed" << std::endl;
+}
+
+void testMisuse() {
+    std::cout << "Testing misuse..." << std::endl;
+
+    [[maybe_unused]] bool threw = false;
+    try {
+        olang::Profiler profiler(0);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+
+    olang::Profiler profiler;
+    // Nothing sampled: nothing to report
+    std::ostringstream folded;
+    profiler.writeFolded(folded);
+    assert(folded.str().empty());
+    assert(profiler.profile().empty());
+
+    std::cout << "  ✓ Misuse test passed" << std::endl;
+}
+
+// Stand-in for the execution engine: runs Main.fib from tests/fibonacci.ol,
+// one tick per dispatched call or builtin operation
+struct FibonacciRun {
+    olang::Profiler& profiler;
+    uint32_t fib, pred, positive;
+
+    template <typename F>
+    long call(uint32_t method, F body) {
+        profiler.enter(method);
+        profiler.tick();
+        long result = body();
+        profiler.leave();
+        return result;
+    }
+
+    long runPositive(long num) {
+        return call(positive, [&] { profiler.tick(); return num > 0 ? 1L : 0L; });
+    }
+
+    long runPred(long num) {
+        return call(pred, [&] {
+            profiler.tick();
+            return runPositive(num) == 0 ? 0 : num - 1;
+        });
+    }
+
+    long runFib(long num) {
+        return call(fib, [&] {
+            profiler.tick();
+            if (num < 2) return 1L;
+            profiler.tick();
+            return runFib(runPred(num)) + runFib(runPred(runPred(num)));
+        });
+    }
+};
+
+void testFibonacciExample() {
+    std::cout << "Testing profile of fibonacci.ol..." << std::endl;
+
+    std::string path = std::string(OLANG_EXAMPLES_DIR) + "/fibonacci.ol";
+    std::ifstream file(path);
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    olang::Lexer lexer(buffer.str());
+    std::vector<olang::Token> tokens = lexer.tokenize();
+    olang::DeclarationParser parser(tokens);
+    std::vector<olang::ClassDecl> classes = parser.parse();
+    assert(parser.errors().empty() && classes.size() == 1);
+
+    // Frames are located by the name token of each method declaration
+    olang::Profiler profiler(7);
+    std::map<std::string, uint32_t> ids;
+    for (const auto& method : classes[0].methods) {
+        ids[method.name] = profiler.addMethod("Main." + method.name, "fibonacci.ol", method.line, method.column);
+    }
+    const auto& ctor = classes[0].constructors.back();
+    uint32_t main = profiler.addMethod("Main.this", "fibonacci.ol", ctor.line, ctor.column);
+
+    FibonacciRun run{profiler, ids.at("fib"), ids.at("pred"), ids.at("positive")};
+    profiler.enter(main);
+    [[maybe_unused]] long result = run.runFib(15);
+    profiler.leave();
+    assert(result == 987);
+
+    std::ostringstream folded;
+    profiler.writeFolded(folded);
+    uint64_t foldedSamples = 0;
+    for (const auto& [stack, count] : parseFolded(folded.str())) {
+        assert(stack.rfind("Main.this", 0) == 0);
+        foldedSamples += count;
+    }
+    assert(foldedSamples == profiler.sampleCount());
+    assert(profiler.sampleCount() > 1000);
+
+    auto profile = profiler.profile();
+    [[maybe_unused]] const auto& fib = entry(profile, ids.at("fib"));
+    [[maybe_unused]] const auto& pred = entry(profile, ids.at("pred"));
+    [[maybe_unused]] const auto& positive = entry(profile, ids.at("positive"));
+    assert(entry(profile, main).total == profiler.sampleCount());
+    assert(fib.total <= profiler.sampleCount() && fib.total >= fib.self);
+    assert(pred.total >= pred.self + positive.self);  // positive is only called from pred
+    assert(positive.total == positive.self);
+    assert(ids.count("succ") && profiler.method(ids.at("succ")).line == 5);
+
+    std::ostringstream table;
+    profiler.writeTable(table);
+    assert(table.str().find("fibonacci.ol:14:12") != std::string::npos);
+
+    std::cout << "  ✓ " << profiler.sampleCount() << " samples over " << folded.str().size()
+              << " bytes of folded stacks" << std::endl;
+}
+
+int main() {
+    std::cout << "Running profiler tests..." << std::endl;
+    std::cout << std::string(50, '=') << std::endl;
+
+    try {
+        testExactCounts();
+        testMisuse();
+        testFibonacciExample();
+
+        std::cout << std::string(50, '=') << std::endl;
+        std::cout << "All tests passed! ✓" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,204 @@
+#include "lexer.h"
+#include "semantic.h"
+#include <cassert>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#ifndef OLANG_EXAMPLES_DIR
+#error "OLANG_EXAMPLES_DIR must point to the directory with example .ol files"
+#endif
+
+olang::SourceUnit unit(const std::string& file, const std::string& source) {
+    olang::Lexer lexer(source);
+    return olang::SourceUnit{file, lexer.tokenize()};
+}
+
+std::vector<std::string> render(const std::vector<olang::Diagnostic>& diagnostics) {
+    std::vector<std::string> lines;
+    for (const auto& diagnostic : diagnostics) {
+        std::ostringstream oss;
+        oss << diagnostic;
+        lines.push_back(oss.str());
+    }
+    return lines;
+}
+
+void testExampleFiles() {
+    std::cout << "Testing example files..." << std::endl;
+    
+    size_t count = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(OLANG_EXAMPLES_DIR)) {
+        if (entry.path().extension() != ".ol") {
+            continue;
+        }
+        std::ifstream file(entry.path());
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        
+        olang::SemanticAnalyzer analyzer;
+        auto diagnostics = analyzer.analyze({unit(entry.path().filename().string(), buffer.str())});
+        for (const auto& line : render(diagnostics)) {
+            std::cerr << line << std::endl;
+        }
+        assert(diagnostics.empty());
+        count++;
+    }
+    assert(count > 0);
+    
+    std::cout << "  ✓ " << count << " example files are clean" << std::endl;
+}
+
+void testInheritance() {
+    std::cout << "Testing inheritance resolution..." << std::endl;
+    
+    // Declared in reverse order: resolution must not depend on it
+    std::string source = R"(
+        class SuperCat extends Cat is
+            method Fight() : String is
+                return this.Sound().Concatenate(this.name)
+            end
+        end
+        class Cat extends Animal is
+            method Sound() : String => "Meow"
+        end
+        class Animal is
+            var name: String
+            method Sound() : String => "Unknown"
+        end
+    )";
+    
+    olang::SemanticAnalyzer analyzer;
+    auto diagnostics = analyzer.analyze({unit("cats.ol", source)});
+    assert(diagnostics.empty());
+    
+    [[maybe_unused]] const olang::ClassInfo* superCat = analyzer.findClass("SuperCat");
+    assert(superCat != nullptr);
+    assert(superCat->depth == 2);
+    assert(superCat->fields.count("name") == 1);
+    assert(superCat->methods.at("Sound").size() == 1);
+    assert(superCat->methods.at("Sound")[0]->body.has_value());
+    assert(analyzer.findClass("Animal")->depth == 0);
+    
+    std::cout << "  ✓ Inheritance resolution test passed" << std::endl;
+}
+
+void testDiagnostics() {
+    std::cout << "Testing diagnostics..." << std::endl;
+    
+    std::string first = R"(class A extends Missing is
+    var x: Integer
+    var x: Strin
+    method f(a: Pair<Integer>) : Integer is
+        var y: Unknown = 1
+        return this.g().Plus(this.z)
+    end
+    method f(b: Pair<Integer>) : Integer => 0
+end
+class Pair<K, V> is
+    this() is base() end
+end
+class B extends C is end
+class C extends B is end
+)";
+    std::string second = R"(class A is end
+class D extends Pair<Integer, Integer> is
+    method m() : Integer => this.v
+end
+class E is
+    method broken(
+end
+)";
+    
+    olang::SemanticAnalyzer analyzer;
+    auto lines = render(analyzer.analyze({unit("first.ol", first), unit("second.ol", second)}));
+    
+    std::vector<std::string> expected = {
+        "first.ol:1:17: error: Unknown base class 'Missing'",
+        "first.ol:3:9: error: Duplicate field 'x' in class 'A'",
+        "first.ol:3:12: error: Unknown type 'Strin'",
+        "first.ol:4:17: error: Class 'Pair' expects 2 type argument(s), got 1",
+        "first.ol:5:16: error: Unknown type 'Unknown'",
+        "first.ol:6:21: error: Unknown method 'g' in class 'A'",
+        "first.ol:6:35: error: Unknown member 'z' in class 'A'",
+        "first.ol:8:12: error: Duplicate method 'f(Pair<Integer>)' in class 'A'",
+        "first.ol:8:17: error: Class 'Pair' expects 2 type argument(s), got 1",
+        "first.ol:11:15: error: 'base' used in class 'Pair', which has no base class",
+        "first.ol:13:17: error: Inheritance cycle through class 'B'",
+        "first.ol:14:17: error: Inheritance cycle through class 'C'",
+        "second.ol:1:1: error: Duplicate class 'A'",
+        "second.ol:3:34: error: Unknown member 'v' in class 'D'",
+        "second.ol:7:1: error: Expected parameter name, found 'end'"
+    };
+    
+    for (const auto& line : lines) {
+        std::cout << "  " << line << std::endl;
+    }
+    assert(lines == expected);
+    
+    std::cout << "  ✓ Diagnostics test passed" << std::endl;
+}
+
+// Many small classes in inheritance chains, some of them with errors
+std::vector<olang::SourceUnit> generatedProject(size_t classes) {
+    std::vector<olang::SourceUnit> units;
+    for (size_t file = 0; file < 8; ++file) {
+        std::ostringstream source;
+        for (size_t i = file; i < classes; i += 8) {
+            source << "class C" << i;
+            if (i >= 8) {
+                source << " extends C" << i - 8;
+            }
+            source << " is\n"
+                   << "    var f" << i << ": Integer\n"
+                   << "    method m" << i << "(x: Integer) : Integer is\n"
+                   << "        if x.Less(1) then return this.f" << i << " end\n"
+                   << "        return this.m" << (i % 5 == 0 ? i + 1 : i) << "(x.Minus(1))\n"
+                   << "    end\n"
+                   << "end\n";
+        }
+        units.push_back(unit("gen" + std::to_string(file) + ".ol", source.str()));
+    }
+    return units;
+}
+
+void testThreadCountIndependence() {
+    std::cout << "Testing determinism across thread counts..." << std::endl;
+    
+    auto units = generatedProject(400);
+    
+    olang::SemanticAnalyzer serial;
+    auto expected = render(serial.analyze(units));
+    assert(!expected.empty());
+    
+    for (size_t threads : {2, 3, 8}) {
+        olang::ThreadPool pool(threads);
+        olang::SemanticAnalyzer parallel(&pool);
+        [[maybe_unused]] std::vector<std::string> rendered = render(parallel.analyze(units));
+        assert(rendered == expected);
+        assert(parallel.classCount() == 400);
+    }
+    
+    std::cout << "  ✓ Determinism test passed" << std::endl;
+}
+
+int main() {
+    std::cout << "Running semantic analyzer tests..." << std::endl;
+    std::cout << std::string(50, '=') << std::endl;
+    
+    try {
+        testExampleFiles();
+        testInheritance();
+        testDiagnostics();
+        testThreadCountIndependence();
+        
+        std::cout << std::string(50, '=') << std::endl;
+        std::cout << "All tests passed! ✓" << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Test failed: " << e.what() << std::endl;
+        return 1;
+    }
+}